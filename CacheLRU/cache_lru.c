@@ -0,0 +1,238 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash.h"
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+typedef void (*cache_lru_desalojar_t)(const char *clave, void *valor, void *extra);
+
+// Enlaces de la lista de uso. La lista es circular y empieza y termina en
+// el centinela de la cache: centinela.siguiente es la clave usada más
+// recientemente y centinela.anterior, la usada hace más tiempo.
+typedef struct enlace {
+	struct enlace *anterior;
+	struct enlace *siguiente;
+} enlace_t;
+
+// La tabla de hash guarda, para cada clave, su nodo. El nodo apunta a la
+// copia de la clave que guarda la tabla, para poder sacarla al desalojarla
+// sin guardarla dos veces.
+typedef struct nodo_lru {
+	enlace_t enlace;
+	void* valor;
+	const char* clave;
+	size_t largo;
+} nodo_lru_t;
+
+typedef struct cache_lru {
+	hash_t* hash;
+	enlace_t centinela;
+	size_t capacidad;
+	size_t aciertos;
+	size_t fallos;
+	hash_destruir_dato_t destruir_dato;
+	cache_lru_desalojar_t desalojar;
+	void* extra;
+} cache_lru_t;
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+static void desenlazar(enlace_t* enlace) {
+
+	enlace->anterior->siguiente = enlace->siguiente;
+	enlace->siguiente->anterior = enlace->anterior;
+}
+
+// Enlaza el nodo al principio de la lista, como el usado más recientemente.
+static void enlazar_primero(cache_lru_t* cache, enlace_t* enlace) {
+
+	enlace->anterior = &cache->centinela;
+	enlace->siguiente = cache->centinela.siguiente;
+	cache->centinela.siguiente->anterior = enlace;
+	cache->centinela.siguiente = enlace;
+}
+
+// Saca de la cache la clave usada hace más tiempo y se la pasa a desalojar.
+// La clave es la copia de la tabla, así que se saca de la tabla después.
+// Pre: la cache no está vacía.
+static void desalojar_ultimo(cache_lru_t* cache) {
+
+	nodo_lru_t* nodo = (nodo_lru_t*) cache->centinela.anterior;
+
+	desenlazar(&nodo->enlace);
+
+	if (cache->desalojar) cache->desalojar(nodo->clave, nodo->valor, cache->extra);
+	else if (cache->destruir_dato) cache->destruir_dato(nodo->valor);
+
+	hash_borrar_dato_bin(cache->hash, nodo->clave, nodo->largo);
+	free(nodo);
+}
+
+/* ******************************************************************
+ *                    PRIMITIVAS DE LA CACHE
+ * *****************************************************************/
+
+cache_lru_t* cache_lru_crear(size_t capacidad, hash_destruir_dato_t destruir_dato, cache_lru_desalojar_t desalojar, void *extra) {
+
+	if (capacidad == 0) return NULL;
+
+	cache_lru_t* cache = malloc(sizeof(cache_lru_t));
+
+	if (!cache) return NULL;
+
+	// Los nodos apuntan a la copia de la clave que guarda la tabla, y la
+	// encadenada no la mueve (la abierta sí).
+	cache->hash = hash_crear(NULL, hash_wyhash);
+
+	// Lugar para una clave más: la nueva se guarda antes de desalojar.
+	if (!cache->hash || !hash_reservar(cache->hash, capacidad + 1)) {
+		if (cache->hash) hash_destruir(cache->hash);
+		free(cache);
+		return NULL;
+	}
+
+	cache->centinela.anterior = &cache->centinela;
+	cache->centinela.siguiente = &cache->centinela;
+	cache->capacidad = capacidad;
+	cache->aciertos = 0;
+	cache->fallos = 0;
+	cache->destruir_dato = destruir_dato;
+	cache->desalojar = desalojar;
+	cache->extra = extra;
+
+	return cache;
+}
+
+bool cache_lru_guardar(cache_lru_t *cache, const char *clave, void *valor) {
+
+	size_t largo = strlen(clave);
+	uint64_t h = hash_calcular_bin(cache->hash, clave, largo);
+	nodo_lru_t* nodo = hash_obtener_con_hash(cache->hash, clave, largo, h);
+
+	if (nodo) {
+
+		if (cache->destruir_dato) cache->destruir_dato(nodo->valor);
+
+		nodo->valor = valor;
+		desenlazar(&nodo->enlace);
+		enlazar_primero(cache, &nodo->enlace);
+
+		return true;
+	}
+
+	nodo = malloc(sizeof(nodo_lru_t));
+
+	if (!nodo) return false;
+
+	// Se desaloja recién después de guardar la clave nueva: si no se puede
+	// guardar, la cache queda como estaba.
+	if (!hash_guardar_con_hash(cache->hash, clave, largo, h, nodo)) {
+		free(nodo);
+		return false;
+	}
+
+	nodo->clave = hash_obtener_clave_con_hash(cache->hash, clave, largo, h);
+	nodo->largo = largo;
+	nodo->valor = valor;
+
+	enlazar_primero(cache, &nodo->enlace);
+
+	if (hash_cantidad(cache->hash) > cache->capacidad) desalojar_ultimo(cache);
+
+	return true;
+}
+
+void *cache_lru_obtener(cache_lru_t *cache, const char *clave) {
+
+	nodo_lru_t* nodo = hash_obtener(cache->hash, clave);
+
+	if (!nodo) {
+		(cache->fallos)++;
+		return NULL;
+	}
+
+	(cache->aciertos)++;
+
+	desenlazar(&nodo->enlace);
+	enlazar_primero(cache, &nodo->enlace);
+
+	return nodo->valor;
+}
+
+bool cache_lru_pertenece(const cache_lru_t *cache, const char *clave) {
+
+	return hash_pertenece(cache->hash, clave);
+}
+
+void *cache_lru_borrar(cache_lru_t *cache, const char *clave) {
+
+	nodo_lru_t* nodo = hash_borrar_dato(cache->hash, clave);
+
+	if (!nodo) return NULL;
+
+	void* valor = nodo->valor;
+
+	desenlazar(&nodo->enlace);
+	free(nodo);
+
+	return valor;
+}
+
+size_t cache_lru_cantidad(const cache_lru_t *cache) {
+
+	return hash_cantidad(cache->hash);
+}
+
+size_t cache_lru_capacidad(const cache_lru_t *cache) {
+
+	return cache->capacidad;
+}
+
+bool cache_lru_cambiar_capacidad(cache_lru_t *cache, size_t capacidad) {
+
+	if (capacidad == 0) return false;
+
+	if (capacidad > cache->capacidad && !hash_reservar(cache->hash, capacidad + 1)) return false;
+
+	while (hash_cantidad(cache->hash) > capacidad)
+		desalojar_ultimo(cache);
+
+	cache->capacidad = capacidad;
+
+	return true;
+}
+
+size_t cache_lru_aciertos(const cache_lru_t *cache) {
+
+	return cache->aciertos;
+}
+
+size_t cache_lru_fallos(const cache_lru_t *cache) {
+
+	return cache->fallos;
+}
+
+void cache_lru_destruir(cache_lru_t *cache) {
+
+	enlace_t* enlace = cache->centinela.siguiente;
+
+	while (enlace != &cache->centinela) {
+
+		nodo_lru_t* nodo = (nodo_lru_t*) enlace;
+
+		enlace = enlace->siguiente;
+
+		if (cache->destruir_dato) cache->destruir_dato(nodo->valor);
+
+		free(nodo);
+	}
+
+	hash_destruir(cache->hash);
+	free(cache);
+}
@@ -0,0 +1,82 @@
+#ifndef CACHE_LRU_H
+#define CACHE_LRU_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "hash.h"
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+// Cache de capacidad fija: al guardar una clave nueva con la cache llena,
+// se desaloja la clave usada hace más tiempo. Guardar y obtener cuestan
+// O(1): las claves están en una tabla de hash y en una lista doblemente
+// enlazada, ordenada por uso, cuyos nodos se mueven sin recorrerla.
+typedef struct cache_lru cache_lru_t;
+
+// Función que recibe cada clave desalojada junto con su valor, que pasa a
+// pertenecerle. La clave deja de existir al terminar la llamada, y durante
+// la llamada no se debe usar la cache.
+typedef void (*cache_lru_desalojar_t)(const char *clave, void *valor, void *extra);
+
+/* ******************************************************************
+ *                    PRIMITIVAS DE LA CACHE
+ * *****************************************************************/
+
+// Crea una cache con lugar para 'capacidad' claves. Los valores que se
+// reemplazan o que quedan al destruirla se destruyen con destruir_dato
+// (si no es NULL). Los desalojados se le pasan a desalojar, con 'extra';
+// si desalojar es NULL, también se destruyen con destruir_dato.
+// Post: devuelve una cache vacía, o NULL si la capacidad es 0 o no hubo memoria.
+cache_lru_t* cache_lru_crear(size_t capacidad, hash_destruir_dato_t destruir_dato, cache_lru_desalojar_t desalojar, void *extra);
+
+// Guarda la clave con su valor como la usada más recientemente. Si ya
+// estaba, reemplaza su valor; si no, y la cache está llena, desaloja la
+// usada hace más tiempo.
+// Pre: la cache fue creada.
+// Post: devuelve false si no hubo memoria.
+bool cache_lru_guardar(cache_lru_t *cache, const char *clave, void *valor);
+
+// Obtiene el valor de una clave y la marca como la usada más recientemente.
+// Cuenta un acierto si estaba y un fallo si no.
+// Pre: la cache fue creada.
+// Post: devuelve el valor de la clave, o NULL si no estaba.
+void *cache_lru_obtener(cache_lru_t *cache, const char *clave);
+
+// Verifica si la clave está en la cache, sin marcarla como usada ni
+// contar aciertos o fallos.
+// Pre: la cache fue creada.
+bool cache_lru_pertenece(const cache_lru_t *cache, const char *clave);
+
+// Quita una clave de la cache sin desalojarla.
+// Pre: la cache fue creada.
+// Post: devuelve su valor (que pasa a pertenecerle al llamador), o NULL si no estaba.
+void *cache_lru_borrar(cache_lru_t *cache, const char *clave);
+
+// Devuelve la cantidad de claves guardadas.
+// Pre: la cache fue creada.
+size_t cache_lru_cantidad(const cache_lru_t *cache);
+
+// Devuelve la cantidad máxima de claves de la cache.
+// Pre: la cache fue creada.
+size_t cache_lru_capacidad(const cache_lru_t *cache);
+
+// Cambia la capacidad de la cache, desalojando las claves usadas hace más
+// tiempo si sobran.
+// Pre: la cache fue creada.
+// Post: devuelve false si la capacidad es 0 o no hubo memoria (en ese
+// caso la cache queda igual).
+bool cache_lru_cambiar_capacidad(cache_lru_t *cache, size_t capacidad);
+
+// Devuelven cuántas veces cache_lru_obtener encontró y no encontró la clave.
+// Pre: la cache fue creada.
+size_t cache_lru_aciertos(const cache_lru_t *cache);
+
+size_t cache_lru_fallos(const cache_lru_t *cache);
+
+// Destruye la cache y, con destruir_dato, los valores que tenía.
+// Pre: la cache fue creada.
+void cache_lru_destruir(cache_lru_t *cache);
+
+#endif // CACHE_LRU_H
@@ -0,0 +1,372 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "lista.h"
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+typedef struct hash hash_t;
+
+typedef struct hash_iter hash_iter_t;
+
+typedef void (*hash_destruir_dato_t)(void *);
+
+// Función de hash: recibe la clave y su largo (sin contar el '\0') y
+// devuelve el hash completo de 64 bits. La tabla se encarga de reducirlo
+// a una posición y lo guarda junto a la clave para no recalcularlo.
+typedef uint64_t (*f_hash_t)(const char* clave, size_t largo);
+
+// Motor de la tabla de hash.
+// HASH_ENCADENADO: arreglo de listas (por defecto).
+// HASH_ABIERTO: direccionamiento abierto con bytes de control recorridos
+// de a 16 (con SSE2 cuando está disponible). Cada ranura (64 bytes) guarda
+// el elemento y, si tiene menos de 32 bytes, la clave: guardar claves
+// cortas no pide memoria y una búsqueda lee una sola ranura. Conviene
+// cuando predominan las búsquedas y la tabla no está casi vacía.
+// HASH_MAPEADO: imagen de sólo lectura abierta con hash_mapear (no se
+// puede pedir a hash_crear_con_tipo).
+// HASH_ORDENADO: los elementos se guardan seguidos, en un arreglo aparte
+// del índice que los ubica. Los iteradores los recorren en el orden en que
+// se insertaron (reemplazar el valor de una clave no cambia su lugar) y
+// sin saltar baldes vacíos.
+typedef enum hash_tipo {
+	HASH_ENCADENADO,
+	HASH_ABIERTO,
+	HASH_MAPEADO,
+	HASH_ORDENADO
+} hash_tipo_t;
+
+// Función que convierte un dato en bytes para guardarlo en una imagen.
+// Devuelve un puntero a los bytes y deja su cantidad en 'largo'. Los bytes
+// siguen perteneciendo al dato: sólo tienen que durar hasta que termine
+// hash_serializar.
+typedef const void* (*hash_serializar_dato_t)(const void* dato, size_t* largo);
+
+// Función que devuelve cuántos bytes ocupa un dato, para el presupuesto de
+// memoria (ver hash_limitar_memoria).
+typedef size_t (*hash_tamanio_dato_t)(const void* dato);
+
+// Política con la que una tabla con presupuesto elige qué desalojar.
+// HASH_DESALOJO_RELOJ: CLOCK (segunda oportunidad). Una aguja recorre la
+// tabla y desaloja la primera clave que no se usó desde su vuelta anterior.
+// HASH_DESALOJO_LRU_MUESTREADO: de unas pocas claves al azar, desaloja la
+// usada hace más tiempo. Se aproxima a LRU sin mantener una lista.
+// HASH_DESALOJO_ALEATORIO: desaloja una clave al azar.
+typedef enum hash_politica {
+	HASH_DESALOJO_RELOJ,
+	HASH_DESALOJO_LRU_MUESTREADO,
+	HASH_DESALOJO_ALEATORIO
+} hash_politica_t;
+
+// Par clave-valor para construir una tabla de una vez con hash_construir.
+typedef struct hash_par {
+	const char* clave;
+	void* dato;
+} hash_par_t;
+
+#define HASH_LARGO_HISTOGRAMA 16
+
+// Estado de una tabla, devuelto por hash_estadisticas.
+// El "largo" depende del motor. En la tabla encadenada es la cantidad de
+// elementos de un balde, e histograma[i] cuenta los baldes con i elementos.
+// En la abierta es la cantidad de grupos que recorre la búsqueda de un
+// elemento, y en la mapeada y la ordenada la de ranuras del índice;
+// histograma[i] cuenta los elementos con largo i. El último casillero
+// acumula los largos mayores.
+// Los campos de búsquedas sólo se cuentan si la biblioteca se compila con
+// HASH_ESTADISTICAS definido (y en ese caso no deben consultarse desde
+// varios hilos a la vez); si no, quedan en 0.
+typedef struct hash_estadisticas {
+	hash_tipo_t tipo;
+	size_t cantidad;
+	size_t baldes;
+	size_t baldes_ocupados;
+	size_t histograma[HASH_LARGO_HISTOGRAMA];
+	size_t largo_maximo;
+	double largo_promedio;
+	size_t redimensiones;
+	size_t bytes;
+	size_t busquedas;
+	double sondeos_por_busqueda;
+	double comparaciones_por_busqueda;
+	size_t desalojos;
+} hash_estadisticas_t;
+
+/* ******************************************************************
+ *                    PRIMITIVAS DEL HASH
+ * *****************************************************************/
+// Crea una tabla de Hash con una función de hash a elección.
+// Post: devuelve una nueva tabla de Hash.
+hash_t *hash_crear(hash_destruir_dato_t destruir_dato, f_hash_t fhash);
+
+// Crea una tabla de Hash que usa hash_wyhash.
+// Post: devuelve una nueva tabla de Hash.
+hash_t* hash_crear_default(hash_destruir_dato_t destruir_dato);
+
+// Crea una tabla de Hash (encadenada) con lugar para 'capacidad' elementos,
+// de manera que cargarlos no necesite redimensionarla.
+// Post: devuelve una nueva tabla de Hash.
+hash_t* hash_crear_con_capacidad(hash_destruir_dato_t destruir_dato, f_hash_t fhash, size_t capacidad);
+
+// Crea una tabla de Hash eligiendo el motor que la implementa.
+// El resto de las primitivas se usan de la misma manera con cualquier motor.
+// Post: devuelve una nueva tabla de Hash del tipo pedido.
+hash_t* hash_crear_con_tipo(hash_destruir_dato_t destruir_dato, f_hash_t fhash, hash_tipo_t tipo);
+
+// Crea una tabla de Hash (encadenada) con los n pares recibidos, repartiendo
+// el trabajo entre hasta 'hilos' hilos. La tabla se dimensiona una sola vez
+// y cada hilo completa un rango de baldes propio, sin candados. Si una
+// clave se repite, queda el valor del último par y los anteriores se
+// destruyen, como al guardarlos uno por uno.
+// Post: devuelve una nueva tabla de Hash con los pares, o NULL si no hubo
+// memoria (en ese caso los datos siguen perteneciendo al llamador).
+hash_t* hash_construir(const hash_par_t pares[], size_t n, hash_destruir_dato_t destruir_dato, f_hash_t fhash, size_t hilos);
+
+// Guarda una nueva clave con su correspodiente valor asociado en el hash.
+// Pre: el hash fue creado.
+// Post: se guardó correctamente la clave con su valor.
+bool hash_guardar(hash_t *hash, const char *clave, void *dato);
+
+// Guarda n claves con sus correspondientes valores (claves[i] con datos[i]).
+// Calcula los hashes de varias claves y precarga sus baldes antes de
+// recorrerlos, por lo que conviene frente a un ciclo de hash_guardar.
+// Pre: el hash fue creado.
+// Post: devuelve true si se guardaron todas las claves. Si devuelve false,
+// las claves anteriores a la que falló quedaron guardadas.
+bool hash_guardar_lote(hash_t *hash, const char* const claves[], void* const datos[], size_t n);
+
+// Borra la clave y su correpondiente valor asociado en el hash.
+// Pre: el hash fue creado. La clave en el hash existe.
+// Post: devuelve el valor asociado a la clave y retira esa clave de la tabla de hash.
+void *hash_borrar_dato(hash_t *hash, const char *clave);
+
+// Borra la clave y su correpondiente valor asociado en el hash.
+// Pre: el hash fue creado. La clave en el hash existe.
+// Post: devuelve true o false dependiendo de si el valor fue distinto de NULL y retira esa clave de la tabla de hash.
+bool hash_borrar(hash_t *hash, const char *clave);
+
+// Obtiene el valor asociado a una clave.
+// Pre: el hash fue creado. La clave existe en el hash.
+// Post: devuelve el valor de la clave, sin retirar la clave del hash.
+void *hash_obtener(const hash_t *hash, const char *clave);
+
+// Obtiene los valores asociados a n claves, superponiendo los accesos a
+// memoria de varias búsquedas.
+// Pre: el hash fue creado. resultados tiene lugar para n valores.
+// Post: resultados[i] es el valor de claves[i], o NULL si no estaba en el hash.
+void hash_obtener_lote(const hash_t *hash, const char* const claves[], size_t n, void* resultados[]);
+
+// Verfica si una clave pertenece o no a una tabla de hash.
+// Pre: el hash fue creado.
+// Post: devuelve verdadero o falso dependiendo de si la clave se encontraba o no en el hash.
+bool hash_pertenece(const hash_t *hash, const char *clave);
+
+// Devuelve el número de elementos que se encuentran en el hash.
+// Pre: el hash fue creado.
+// Post: devuelve un número positivo indicando la cantidad de elementos guardados en el hash.
+size_t hash_cantidad(const hash_t *hash);
+
+// Agranda la tabla para que entren 'cantidad' elementos sin redimensionarla.
+// La tabla no se achica por debajo de ese tamaño al borrar elementos.
+// Pre: el hash fue creado.
+// Post: devuelve false si no hubo memoria para agrandarla.
+bool hash_reservar(hash_t *hash, size_t cantidad);
+
+// Achica la tabla al menor tamaño en el que entran sus elementos, devolviendo
+// la memoria sobrante, y deja sin efecto lo reservado con hash_reservar.
+// Pre: el hash fue creado.
+// Post: devuelve false si no hubo memoria para reconstruirla.
+bool hash_compactar(hash_t *hash);
+
+// Agrega a la tabla un filtro de Bloom (por bloques) con bits_por_clave
+// bits por clave, o reemplaza el que tenía. Con el filtro, hash_obtener y
+// hash_pertenece de una clave que no está casi nunca tocan los baldes: sólo
+// los recorren ante un falso positivo (alrededor del 1% con 10 bits por
+// clave). El filtro se reconstruye cuando se llena, creciendo con la tabla
+// y descartando las claves borradas, y también en hash_compactar.
+// Pre: el hash fue creado.
+// Post: devuelve false si no hubo memoria o si el hash es una imagen mapeada.
+bool hash_agregar_filtro(hash_t *hash, size_t bits_por_clave);
+
+// Quita el filtro de la tabla, si tenía uno.
+// Pre: el hash fue creado.
+void hash_quitar_filtro(hash_t *hash);
+
+// Limita la memoria de la tabla a 'presupuesto' bytes, contando los nodos
+// (con sus claves) y, con tamanio_dato, los datos. Cuando un guardado lo
+// supera, se desalojan claves según la política hasta volver a entrar,
+// destruyendo sus datos con destruir_dato; la clave recién guardada nunca
+// se desaloja. Si ya lo supera, se desaloja en el momento. Con presupuesto
+// 0 se quita el límite.
+// El tamaño de un dato no debe cambiar mientras esté en la tabla. Con
+// presupuesto, hash_obtener y hash_pertenece marcan la clave como usada,
+// así que no pueden llamarse desde varios hilos a la vez.
+// Pre: el hash fue creado.
+// Post: devuelve false si el hash es una imagen mapeada o la política no existe.
+bool hash_limitar_memoria(hash_t *hash, size_t presupuesto, hash_tamanio_dato_t tamanio_dato, hash_politica_t politica);
+
+// Devuelve los bytes que cuenta el presupuesto de la tabla, o 0 si no tiene.
+// Pre: el hash fue creado.
+size_t hash_memoria(const hash_t *hash);
+
+// Cambia los factores de carga (elementos por balde) con los que la tabla
+// crece y se achica. El máximo sólo se usa en la tabla encadenada: la abierta
+// siempre crece al llenar 7/8 de sus ranuras, y se achica por debajo del
+// mínimo o de 7/32, lo que sea menor.
+// Pre: el hash fue creado.
+// Post: devuelve false si los factores no dejan margen entre crecer y achicarse.
+bool hash_configurar_factores(hash_t *hash, float factor_min, float factor_max);
+
+// Completa estadisticas con el estado de la tabla: cómo se reparten los
+// elementos (baldes ocupados, histograma, largo máximo y promedio sobre los
+// ocupados), cuántas veces se redimensionó, cuántos bytes ocupan la
+// tabla y sus nodos, cuántas claves desalojó el presupuesto y, por
+// búsqueda, cuántos nodos se examinaron (sondeos) y cuántas claves se
+// compararon byte a byte (comparaciones).
+// Pre: el hash fue creado.
+void hash_estadisticas(const hash_t *hash, hash_estadisticas_t *estadisticas);
+
+// Devuelve una lista con todas las claves del hash.
+lista_t* hash_claves(const hash_t* hash);
+
+// Copia en el arreglo recibido hasta tam claves del hash, sin reservar memoria.
+// Las claves siguen perteneciendo al hash.
+// Pre: el hash fue creado. claves tiene lugar para tam elementos.
+// Post: devuelve la cantidad de claves copiadas.
+size_t hash_claves_arreglo(const hash_t* hash, const char* claves[], size_t tam);
+
+// Escribe en el archivo una imagen binaria del hash, que después puede
+// abrirse con hash_mapear sin reconstruir la tabla. Cada dato se guarda con
+// los bytes que devuelve serializar_dato; si es NULL, sólo se guardan las claves.
+// Pre: el hash fue creado. fd es un archivo abierto para escritura.
+// Post: devuelve true si se pudo escribir la imagen completa.
+bool hash_serializar(const hash_t *hash, int fd, hash_serializar_dato_t serializar_dato);
+
+// Abre en modo de sólo lectura una imagen escrita por hash_serializar,
+// mapeándola en memoria sin leerla ni interpretarla.
+// hash_obtener devuelve un puntero a los bytes guardados del dato (que no
+// deben modificarse). hash_guardar y hash_borrar_dato no tienen efecto.
+// Las entradas de una imagen truncada o corrupta que no caen dentro del
+// archivo se ignoran al buscarlas y al recorrerlas.
+// Post: devuelve el hash, o NULL si el encabezado no es de una imagen válida
+// o si el largo del archivo no es múltiplo de 8.
+hash_t* hash_mapear(const char *ruta);
+
+// Destruye la tabla de hash.
+// Pre: el hash fue creado.
+// Post: destruye el hash y todos los elementos que contenía.
+void hash_destruir(hash_t *hash);
+
+/* ******************************************************************
+ *                 PRIMITIVAS CON CLAVES BINARIAS
+ * *****************************************************************/
+
+// Equivalentes a las primitivas anteriores, pero la clave es una secuencia
+// de 'largo' bytes cualesquiera (puede contener '\0'). Una clave de texto
+// guardada con hash_guardar es la misma que sus bytes sin el '\0' final.
+// Al recorrer el hash, estas claves se ven con un '\0' agregado al final.
+// Las claves no pueden superar los UINT32_MAX bytes.
+
+bool hash_guardar_bin(hash_t *hash, const void *clave, size_t largo, void *dato);
+
+void *hash_borrar_dato_bin(hash_t *hash, const void *clave, size_t largo);
+
+void *hash_obtener_bin(const hash_t *hash, const void *clave, size_t largo);
+
+bool hash_pertenece_bin(const hash_t *hash, const void *clave, size_t largo);
+
+/* ******************************************************************
+ *               PRIMITIVAS CON EL HASH YA CALCULADO
+ * *****************************************************************/
+
+// Para los TDAs construidos sobre el hash (como hash_concurrente_t) que
+// necesitan el hash de la clave antes de elegir en qué tabla buscarla: se
+// calcula una sola vez con hash_calcular_bin y las demás lo reciben en 'h'
+// en lugar de volver a calcularlo. Tablas creadas con la misma función de
+// hash dan el mismo valor para la misma clave.
+// Pre: h es el que devuelve hash_calcular_bin para la misma clave en una
+// tabla con la misma función de hash.
+
+uint64_t hash_calcular_bin(const hash_t *hash, const void *clave, size_t largo);
+
+bool hash_guardar_con_hash(hash_t *hash, const void *clave, size_t largo, uint64_t h, void *dato);
+
+void *hash_borrar_dato_con_hash(hash_t *hash, const void *clave, size_t largo, uint64_t h);
+
+void *hash_obtener_con_hash(const hash_t *hash, const void *clave, size_t largo, uint64_t h);
+
+bool hash_pertenece_con_hash(const hash_t *hash, const void *clave, size_t largo, uint64_t h);
+
+// Devuelve la copia de la clave que guarda la tabla (con un '\0' al
+// final), o NULL si no está. Salvo en HASH_ABIERTO, la copia no se mueve
+// mientras la clave siga guardada, así que sirve para referirse a la clave
+// sin guardarla dos veces. En HASH_ABIERTO las claves cortas se guardan en
+// la ranura y se mueven cada vez que la tabla se reconstruye.
+const char *hash_obtener_clave_con_hash(const hash_t *hash, const void *clave, size_t largo, uint64_t h);
+
+/* ******************************************************************
+ *                 PRIMITIVA DEL ITERADOR INTERNO
+ * *****************************************************************/
+
+// Itera sobre el hash de manera interna sin reservar memoria. Recibe una
+// función visitar que se llama con cada clave, su dato y el parámetro extra,
+// y que devuelve verdadero si se debe seguir iterando o falso en caso contrario.
+// Pre: el hash fue creado. visitar no modifica el hash.
+// Post: se llamó a visitar con cada elemento hasta que devolvió falso.
+void hash_iterar(const hash_t *hash, bool (*visitar)(const char *clave, void *dato, void *extra), void *extra);
+
+/* ******************************************************************
+ *                    FUNCIONES DE HASH
+ * *****************************************************************/
+
+// Funciones de hash para pasarle a hash_crear. Recorren la clave de a 8
+// bytes o más, en lugar de byte a byte.
+
+// FNV-1a aplicado de a palabras de 8 bytes (y byte a byte en el resto).
+uint64_t hash_fnv1a(const char *clave, size_t largo);
+
+// Variante de wyhash: combina bloques de 16 bytes con multiplicaciones de
+// 128 bits. Es la más rápida en general y la que usa hash_crear_default.
+uint64_t hash_wyhash(const char *clave, size_t largo);
+
+// CRC32C calculado en dos cadenas que se alternan las palabras de la
+// clave, y que forman las dos mitades del resultado. Si se compila con
+// SSE4.2 (-msse4.2) usa la instrucción crc32; si no, una tabla, mucho más
+// lenta, que da el mismo resultado.
+uint64_t hash_crc32c(const char *clave, size_t largo);
+
+/* ******************************************************************
+ *                    PRIMITIVAS DEL ITERADOR
+ * *****************************************************************/
+
+// Crea un nuevo iterador de hash.
+// Pre: el hash fue creado.
+// Post: devuelve un nuevo iterador de hash.
+hash_iter_t *hash_iter_crear(const hash_t *hash);
+
+// Avanza sobre el hash de un elemento a la vez.
+// Pre: el hash y el iterador fueron creados.
+// Post: se movió una posición en el hash, devuelve verdadero si lo pudo concretar o falso en caso contrario.
+bool hash_iter_avanzar(hash_iter_t *iter);
+
+// Devuelve la clave a la cual esta apuntando el iterador en ese momento.
+// Pre: el hash y el iterador fueron creados.
+// Post: devuelve la clave actual.
+const char *hash_iter_ver_actual(const hash_iter_t *iter);
+
+// Se fija si el iterador está al final del hash.
+// Pre: el hash y el iterador fueron creados.
+// Post: devuelve verdadero en caso de que el iterador se encuentre al final del hash o falso en caso contrario.
+bool hash_iter_al_final(const hash_iter_t *iter);
+
+// Destruye el iterador.
+// Pre: el hash y el iterador fueron creados.
+// Post: el iterador  fue destruido.
+void hash_iter_destruir(hash_iter_t* iter);
+
+#endif // HASH_H
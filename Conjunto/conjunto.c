@@ -1,38 +1,2295 @@
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#if (defined(__AVX2__) && defined(__BMI2__)) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
 
 #define FACTOR 2
 
+/* Tabla de hash: tamaño potencia de dos, que crece al superar 3/4 de
+ * ranuras ocupadas. */
+#define TAM_MINIMO_HASH 8
+#define OCUPACION_MAXIMA_NUM 3
+#define OCUPACION_MAXIMA_DEN 4
+
+/* Las operaciones entre dos conjuntos ordenados recorren ambos a la par,
+ * salvo que uno tenga más de UMBRAL_GALOPE veces los datos del otro: en
+ * ese caso se recorre el chico y se galopa sobre el grande. */
+#define UMBRAL_GALOPE 16
+
+/* Los núcleos vectoriales de los conjuntos de enteros escriben bloques
+ * enteros aunque solo valgan algunos de sus enteros: el arreglo del
+ * resultado tiene HOLGURA_SIMD lugares más que los que puede ocupar. */
+#define HOLGURA_SIMD 8
+
+/* Contenedores de los conjuntos de mapa de bits: cada uno cubre 2^16
+ * valores, y pasa de arreglo a mapa al superar MAX_ARREGLO (donde el
+ * arreglo ocupa lo mismo que el mapa, BYTES_MAPA). */
+#define MAX_ARREGLO 4096
+#define PALABRAS_MAPA 1024
+#define BYTES_MAPA (PALABRAS_MAPA * sizeof(uint64_t))
+#define TAM_MINIMO_ARREGLO 4
+
+/* Las operaciones paralelas no reparten en más hilos que uno cada
+ * MIN_DATOS_POR_HILO datos de entrada. */
+#define MIN_DATOS_POR_HILO 65536
+
 /* ******************************************************************
  *                DEFINICION DE LOS TIPOS DE DATOS
  * *****************************************************************/
 
-typedef int (*cmp_func_t) (const void *a, const void *b);
+typedef int (*cmp_func_t) (const void *a, const void *b);
+
+typedef void (*destruir_dato_t) (void *);
+
+typedef uint64_t (*conjunto_hash_func_t) (const void *dato);
+
+/* CONJUNTO_ARREGLO guarda los datos seguidos en 'datos', sin orden.
+ * CONJUNTO_HASH los guarda en las ranuras de una tabla con sondeo lineal:
+ * 'hashes' tiene, para cada ranura, el hash de su dato con el bit más
+ * bajo en 1, o 0 si está libre. Así los datos pueden ser NULL, y ni las
+ * búsquedas ni las redimensiones vuelven a llamar a la función de hash.
+ * CONJUNTO_ORDENADO guarda los datos seguidos en 'datos', de menor a mayor
+ * según cmp.
+ * CONJUNTO_ENTEROS guarda enteros sin signo de 32 bits, de menor a mayor,
+ * en 'enteros' (y no usa 'datos'): se comparan sin llamar a cmp, de a
+ * bloques cuando el procesador lo permite.
+ * CONJUNTO_BITMAP también guarda enteros de 32 bits, en los
+ * 'cant_contenedores' contenedores de 'contenedores' (con lugar para
+ * 'tam'), ordenados por clave. */
+typedef enum conjunto_tipo {
+	CONJUNTO_ARREGLO,
+	CONJUNTO_HASH,
+	CONJUNTO_ORDENADO,
+	CONJUNTO_ENTEROS,
+	CONJUNTO_BITMAP
+} conjunto_tipo_t;
+
+/* Un contenedor guarda los enteros cuyos 16 bits altos son su clave, y de
+ * cada uno solo los 16 bits bajos (como los "roaring bitmaps"):
+ * CONTENEDOR_ARREGLO los guarda ordenados en 'valores' (con lugar para
+ * 'tam'), y 'largo' es igual a 'cant'.
+ * CONTENEDOR_MAPA tiene un bit por valor posible en 'palabras'.
+ * CONTENEDOR_TRAMOS guarda en 'valores' 'largo' pares (inicio, largo - 1)
+ * de valores consecutivos, ordenados (con lugar para 'tam' pares).
+ * Ningún contenedor está vacío. */
+typedef enum contenedor_tipo {
+	CONTENEDOR_ARREGLO,
+	CONTENEDOR_MAPA,
+	CONTENEDOR_TRAMOS
+} contenedor_tipo_t;
+
+typedef struct contenedor {
+	uint16_t clave;
+	contenedor_tipo_t tipo;
+	uint32_t cant;
+	uint32_t largo;
+	uint32_t tam;
+	uint16_t* valores;
+	uint64_t* palabras;
+} contenedor_t;
+
+typedef enum operacion {
+	OPERACION_UNION,
+	OPERACION_INTERSECCION,
+	OPERACION_DIFERENCIA
+} operacion_t;
+
+typedef struct conjunto {
+	void* *datos;
+	size_t cant;
+	size_t tam;
+	cmp_func_t cmp;
+	destruir_dato_t destruir_dato;
+	conjunto_tipo_t tipo;
+	conjunto_hash_func_t fhash;
+	uint64_t *hashes;
+	uint32_t *enteros;
+	contenedor_t *contenedores;
+	size_t cant_contenedores;
+} conjunto_t;
+
+/* Un iterador recorre un conjunto (una hoja) o combina otros dos, 'izq' y
+ * 'der', que le pertenecen, sin guardar el resultado: cada avance mueve
+ * solo lo necesario de cada uno. Las combinaciones necesitan recorrer sus
+ * hojas en orden ('ordenado'), para avanzar a la par. El dato actual es
+ * 'actual' o, en los iteradores de enteros, 'entero'. Las hojas usan 'pos'
+ * como posición en el conjunto (o contenedor, en los mapas de bits) e
+ * 'indice' como posición en el contenedor. */
+typedef enum iter_tipo {
+	ITER_CONJUNTO,
+	ITER_UNION,
+	ITER_INTERSECCION,
+	ITER_DIFERENCIA,
+	ITER_DIFERENCIA_SIMETRICA
+} iter_tipo_t;
+
+typedef struct conjunto_iter {
+	iter_tipo_t tipo;
+	const conjunto_t* conjunto;
+	struct conjunto_iter* izq;
+	struct conjunto_iter* der;
+	cmp_func_t cmp;
+	bool de_enteros;
+	bool ordenado;
+	bool al_final;
+	size_t pos;
+	size_t indice;
+	void* actual;
+	uint32_t entero;
+} conjunto_iter_t;
+
+/* Las operaciones paralelas cortan ambos conjuntos en tramos de claves
+ * consecutivas, uno por hilo: el trabajo opera datos1[desde1, hasta1) con
+ * datos2[desde2, hasta2) y escribe sus 'cant' datos en el arreglo del
+ * resultado desde la posición 'salida', con lugar para el peor caso; al
+ * final se juntan. */
+typedef struct trabajo {
+	const conjunto_t* conjunto1;
+	const conjunto_t* conjunto2;
+	conjunto_t* resultado;
+	operacion_t operacion;
+	size_t desde1, hasta1;
+	size_t desde2, hasta2;
+	size_t salida;
+	size_t cant;
+	pthread_t hilo;
+	bool creado;
+} trabajo_t;
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+/* Redimensiona el conjunto. */
+static bool redimensionar_conjunto(conjunto_t* conjunto, size_t tam_nuevo) {
+
+	void* datos_nuevo = realloc(conjunto->datos, tam_nuevo * sizeof(void*));
+
+	if (!datos_nuevo) return false;
+
+	conjunto->datos = datos_nuevo;
+	conjunto->tam = tam_nuevo;
+
+	return true;
+}
+
+/* Verifica si el conjunto es de enteros, de cualquiera de sus tipos. */
+static bool es_de_enteros(const conjunto_t* conjunto) {
+
+	return conjunto->tipo == CONJUNTO_ENTEROS || conjunto->tipo == CONJUNTO_BITMAP;
+}
+
+/* Devuelve la cantidad de posiciones que hay que recorrer para ver todos
+ * los datos: los guardados en el arreglo o todas las ranuras de la tabla.
+ * Los conjuntos de enteros no tienen datos. */
+static size_t conjunto_posiciones(const conjunto_t* conjunto) {
+
+	if (es_de_enteros(conjunto)) return 0;
+
+	return (conjunto->tipo == CONJUNTO_HASH) ? conjunto->tam : conjunto->cant;
+}
+
+/* Devuelve verdadero si la posición i tiene un dato. */
+static bool conjunto_ocupada(const conjunto_t* conjunto, size_t i) {
+
+	return (conjunto->tipo != CONJUNTO_HASH) || (conjunto->hashes[i] != 0);
+}
+
+/* ******************************************************************
+ *                 FUNCIONES AUXILIARES DE LA TABLA
+ * *****************************************************************/
+
+/* Finalizador de MurmurHash3: reparte en los bits bajos, que eligen la
+ * ranura, lo que la función del usuario haya dejado en los altos. Deja el
+ * bit más bajo en 1 para distinguir las ranuras ocupadas. */
+static uint64_t hash_dato(const conjunto_t* conjunto, const void* dato) {
+
+	uint64_t h = conjunto->fhash(dato);
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+
+	return h | 1;
+}
+
+/* Devuelve el menor tamaño de tabla en el que entran 'cantidad' datos. */
+static size_t tabla_tamanio_para(size_t cantidad) {
+
+	size_t tam = TAM_MINIMO_HASH;
+
+	while (cantidad * OCUPACION_MAXIMA_DEN > tam * OCUPACION_MAXIMA_NUM)
+		tam *= 2;
+
+	return tam;
+}
+
+/* Devuelve la ranura del dato, o la primera libre de su recorrido si no está. */
+static size_t tabla_buscar(const conjunto_t* conjunto, const void* dato, uint64_t h) {
+
+	size_t mascara = conjunto->tam - 1;
+	size_t i = (h >> 1) & mascara;
+
+	while (conjunto->hashes[i] != 0) {
+
+		if (conjunto->hashes[i] == h && conjunto->cmp(conjunto->datos[i], dato) == 0) return i;
+
+		i = (i + 1) & mascara;
+	}
+
+	return i;
+}
+
+/* Reserva una tabla vacía de 'tam' ranuras. */
+static bool tabla_inicializar(conjunto_t* conjunto, size_t tam) {
+
+	conjunto->datos = malloc(tam * sizeof(void*));
+	conjunto->hashes = calloc(tam, sizeof(uint64_t));
+
+	if (!conjunto->datos || !conjunto->hashes) {
+		free(conjunto->datos);
+		free(conjunto->hashes);
+		return false;
+	}
+
+	conjunto->tam = tam;
+
+	return true;
+}
+
+/* Reubica los datos en una tabla nueva de 'tam_nuevo' ranuras. */
+static bool tabla_redimensionar(conjunto_t* conjunto, size_t tam_nuevo) {
+
+	void* *datos_viejos = conjunto->datos;
+	uint64_t *hashes_viejos = conjunto->hashes;
+	size_t tam_viejo = conjunto->tam;
+
+	if (!tabla_inicializar(conjunto, tam_nuevo)) {
+		conjunto->datos = datos_viejos;
+		conjunto->hashes = hashes_viejos;
+		return false;
+	}
+
+	for (size_t i = 0; i < tam_viejo; i++) {
+
+		if (hashes_viejos[i] == 0) continue;
+
+		size_t j = (hashes_viejos[i] >> 1) & (tam_nuevo - 1);
+
+		while (conjunto->hashes[j] != 0)
+			j = (j + 1) & (tam_nuevo - 1);
+
+		conjunto->hashes[j] = hashes_viejos[i];
+		conjunto->datos[j] = datos_viejos[i];
+	}
+
+	free(datos_viejos);
+	free(hashes_viejos);
+
+	return true;
+}
+
+/* Libera la ranura i corriendo hacia atrás los datos que le siguen en el
+ * mismo recorrido, para no dejar marcas de borrado. */
+static void tabla_liberar(conjunto_t* conjunto, size_t i) {
+
+	size_t mascara = conjunto->tam - 1;
+	size_t j = i;
+
+	while (true) {
+
+		conjunto->hashes[i] = 0;
+
+		/* Busca el próximo dato que pueda ocupar la ranura i: uno cuya
+		 * ranura ideal no esté entre i (exclusive) y su posición. */
+		size_t ideal;
+
+		do {
+			j = (j + 1) & mascara;
+
+			if (conjunto->hashes[j] == 0) return;
+
+			ideal = (conjunto->hashes[j] >> 1) & mascara;
+
+		} while (((j - ideal) & mascara) < ((j - i) & mascara));
+
+		conjunto->hashes[i] = conjunto->hashes[j];
+		conjunto->datos[i] = conjunto->datos[j];
+		i = j;
+	}
+}
+
+/* Crea un conjunto vacío del mismo tipo que 'modelo', con lugar para
+ * 'capacidad' datos. */
+static conjunto_t* conjunto_crear_como(const conjunto_t* modelo, size_t capacidad) {
+
+	conjunto_t* conjunto = malloc(sizeof(conjunto_t));
+
+	if (!conjunto) return NULL;
+
+	conjunto->cant = 0;
+	conjunto->cmp = modelo->cmp;
+	conjunto->destruir_dato = modelo->destruir_dato;
+	conjunto->tipo = modelo->tipo;
+	conjunto->fhash = modelo->fhash;
+	conjunto->hashes = NULL;
+	conjunto->enteros = NULL;
+	conjunto->contenedores = NULL;
+	conjunto->cant_contenedores = 0;
+
+	if (modelo->tipo == CONJUNTO_HASH) {
+
+		if (!tabla_inicializar(conjunto, tabla_tamanio_para(capacidad))) {
+			free(conjunto);
+			return NULL;
+		}
+
+		return conjunto;
+	}
+
+	if (capacidad == 0) capacidad = 1;
+
+	if (modelo->tipo == CONJUNTO_BITMAP) {
+
+		conjunto->datos = NULL;
+		conjunto->contenedores = malloc(capacidad * sizeof(contenedor_t));
+
+		if (!conjunto->contenedores) {
+			free(conjunto);
+			return NULL;
+		}
+
+		conjunto->tam = capacidad;
+
+		return conjunto;
+	}
+
+	if (modelo->tipo == CONJUNTO_ENTEROS) {
+
+		conjunto->datos = NULL;
+		conjunto->enteros = malloc((capacidad + HOLGURA_SIMD) * sizeof(uint32_t));
+
+		if (!conjunto->enteros) {
+			free(conjunto);
+			return NULL;
+		}
+
+		conjunto->tam = capacidad;
+
+		return conjunto;
+	}
+
+	conjunto->datos = malloc(capacidad * sizeof(void*));
+
+	if (!conjunto->datos) {
+		free(conjunto);
+		return NULL;
+	}
+
+	conjunto->tam = capacidad;
+
+	return conjunto;
+}
+
+/* ******************************************************************
+ *             FUNCIONES AUXILIARES DEL ARREGLO ORDENADO
+ * *****************************************************************/
+
+/* Devuelve la primera posición entre bajo (inclusive) y alto (exclusive)
+ * cuyo dato no es menor que 'dato', o alto si no hay ninguna. */
+static size_t ordenado_posicion(const conjunto_t* conjunto, size_t bajo, size_t alto, const void* dato) {
+
+	while (bajo < alto) {
+
+		size_t medio = bajo + (alto - bajo) / 2;
+
+		if (conjunto->cmp(conjunto->datos[medio], dato) < 0) bajo = medio + 1;
+		else alto = medio;
+	}
+
+	return bajo;
+}
+
+/* Igual que ordenado_posicion desde 'desde' hasta el final, pero primero
+ * avanza con saltos que se duplican hasta pasar el dato: cuesta O(log d),
+ * con d la distancia entre 'desde' y la posición encontrada. */
+static size_t ordenado_galopar(const conjunto_t* conjunto, size_t desde, const void* dato) {
+
+	size_t bajo = desde;
+	size_t salto = 1;
+
+	while (bajo + salto - 1 < conjunto->cant && conjunto->cmp(conjunto->datos[bajo + salto - 1], dato) < 0) {
+		bajo += salto;
+		salto *= 2;
+	}
+
+	size_t alto = (bajo + salto - 1 < conjunto->cant) ? bajo + salto - 1 : conjunto->cant;
+
+	return ordenado_posicion(conjunto, bajo, alto, dato);
+}
+
+/* Verifica si la posición i tiene un dato igual a 'dato'. */
+static bool ordenado_es(const conjunto_t* conjunto, size_t i, const void* dato) {
+
+	return i < conjunto->cant && conjunto->cmp(conjunto->datos[i], dato) == 0;
+}
+
+/* Agrega al final los datos de 'origen' entre desde (inclusive) y hasta
+ * (exclusive). Pre: entran sin redimensionar y mantienen el orden. */
+static void ordenado_copiar(conjunto_t* destino, const conjunto_t* origen, size_t desde, size_t hasta) {
+
+	memcpy(destino->datos + destino->cant, origen->datos + desde, (hasta - desde) * sizeof(void*));
+	destino->cant += hasta - desde;
+}
+
+/* Agrega un dato al final. Pre: entra sin redimensionar y mantiene el orden. */
+static void ordenado_anexar(conjunto_t* conjunto, void* dato) {
+
+	conjunto->datos[(conjunto->cant)++] = dato;
+}
+
+/* Verifica si ambos conjuntos están ordenados con el mismo criterio, para
+ * operar entre ellos recorriéndolos a la par. */
+static bool ordenados_a_la_par(const conjunto_t* conjunto1, const conjunto_t* conjunto2) {
+
+	return conjunto1->tipo == CONJUNTO_ORDENADO && conjunto2->tipo == CONJUNTO_ORDENADO && conjunto1->cmp == conjunto2->cmp;
+}
+
+/* Verifica si uno de los conjuntos es tanto más chico que conviene galopar. */
+static bool conviene_galopar(const conjunto_t* chico, const conjunto_t* grande) {
+
+	return chico->cant * UMBRAL_GALOPE < grande->cant;
+}
+
+/* Unión de dos conjuntos ordenados. Si un dato está en ambos, queda el de conjunto1. */
+static conjunto_t* ordenado_union(const conjunto_t* conjunto1, const conjunto_t* conjunto2) {
+
+	conjunto_t* c_union = conjunto_crear_como(conjunto1, conjunto1->cant + conjunto2->cant);
+
+	if (!c_union) return NULL;
+
+	bool chico_es_1 = conviene_galopar(conjunto1, conjunto2);
+
+	if (chico_es_1 || conviene_galopar(conjunto2, conjunto1)) {
+
+		const conjunto_t* chico = chico_es_1 ? conjunto1 : conjunto2;
+		const conjunto_t* grande = chico_es_1 ? conjunto2 : conjunto1;
+		size_t j = 0;
+
+		for (size_t i = 0; i < chico->cant; i++) {
+
+			size_t hasta = ordenado_galopar(grande, j, chico->datos[i]);
+
+			ordenado_copiar(c_union, grande, j, hasta);
+			j = hasta;
+
+			if (ordenado_es(grande, j, chico->datos[i])) {
+				ordenado_anexar(c_union, chico_es_1 ? chico->datos[i] : grande->datos[j]);
+				j++;
+			} else {
+				ordenado_anexar(c_union, chico->datos[i]);
+			}
+		}
+
+		ordenado_copiar(c_union, grande, j, grande->cant);
+
+		return c_union;
+	}
+
+	size_t i = 0, j = 0;
+
+	while (i < conjunto1->cant && j < conjunto2->cant) {
+
+		int comparacion = conjunto1->cmp(conjunto1->datos[i], conjunto2->datos[j]);
+
+		if (comparacion <= 0) ordenado_anexar(c_union, conjunto1->datos[i++]);
+		else ordenado_anexar(c_union, conjunto2->datos[j++]);
+
+		if (comparacion == 0) j++;
+	}
+
+	ordenado_copiar(c_union, conjunto1, i, conjunto1->cant);
+	ordenado_copiar(c_union, conjunto2, j, conjunto2->cant);
+
+	return c_union;
+}
+
+/* Intersección de dos conjuntos ordenados, con los datos de conjunto1. */
+static conjunto_t* ordenado_interseccion(const conjunto_t* conjunto1, const conjunto_t* conjunto2) {
+
+	size_t capacidad = (conjunto1->cant < conjunto2->cant) ? conjunto1->cant : conjunto2->cant;
+	conjunto_t* c_inter = conjunto_crear_como(conjunto1, capacidad);
+
+	if (!c_inter) return NULL;
+
+	bool chico_es_1 = conviene_galopar(conjunto1, conjunto2);
+
+	if (chico_es_1 || conviene_galopar(conjunto2, conjunto1)) {
+
+		const conjunto_t* chico = chico_es_1 ? conjunto1 : conjunto2;
+		const conjunto_t* grande = chico_es_1 ? conjunto2 : conjunto1;
+		size_t j = 0;
+
+		for (size_t i = 0; i < chico->cant && j < grande->cant; i++) {
+
+			j = ordenado_galopar(grande, j, chico->datos[i]);
+
+			if (ordenado_es(grande, j, chico->datos[i])) {
+				ordenado_anexar(c_inter, chico_es_1 ? chico->datos[i] : grande->datos[j]);
+				j++;
+			}
+		}
+
+		return c_inter;
+	}
+
+	size_t i = 0, j = 0;
+
+	while (i < conjunto1->cant && j < conjunto2->cant) {
+
+		int comparacion = conjunto1->cmp(conjunto1->datos[i], conjunto2->datos[j]);
+
+		if (comparacion == 0) ordenado_anexar(c_inter, conjunto1->datos[i]);
+
+		if (comparacion <= 0) i++;
+		if (comparacion >= 0) j++;
+	}
+
+	return c_inter;
+}
+
+/* Diferencia de dos conjuntos ordenados: los datos de conjunto1 que no
+ * están en conjunto2. */
+static conjunto_t* ordenado_diferencia(const conjunto_t* conjunto1, const conjunto_t* conjunto2) {
+
+	conjunto_t* c_dif = conjunto_crear_como(conjunto1, conjunto1->cant);
+
+	if (!c_dif) return NULL;
+
+	size_t i = 0, j = 0;
+
+	/* Si conjunto2 es chico, se copian de a tramos los datos de conjunto1
+	 * que quedan entre dos de los suyos. */
+	if (conviene_galopar(conjunto2, conjunto1)) {
+
+		for (j = 0; j < conjunto2->cant; j++) {
+
+			size_t hasta = ordenado_galopar(conjunto1, i, conjunto2->datos[j]);
+
+			ordenado_copiar(c_dif, conjunto1, i, hasta);
+			i = ordenado_es(conjunto1, hasta, conjunto2->datos[j]) ? hasta + 1 : hasta;
+		}
+
+		ordenado_copiar(c_dif, conjunto1, i, conjunto1->cant);
+
+		return c_dif;
+	}
+
+	if (conviene_galopar(conjunto1, conjunto2)) {
+
+		for (i = 0; i < conjunto1->cant; i++) {
+
+			j = ordenado_galopar(conjunto2, j, conjunto1->datos[i]);
+
+			if (!ordenado_es(conjunto2, j, conjunto1->datos[i])) ordenado_anexar(c_dif, conjunto1->datos[i]);
+		}
+
+		return c_dif;
+	}
+
+	while (i < conjunto1->cant && j < conjunto2->cant) {
+
+		int comparacion = conjunto1->cmp(conjunto1->datos[i], conjunto2->datos[j]);
+
+		if (comparacion < 0) ordenado_anexar(c_dif, conjunto1->datos[i]);
+
+		if (comparacion <= 0) i++;
+		if (comparacion >= 0) j++;
+	}
+
+	ordenado_copiar(c_dif, conjunto1, i, conjunto1->cant);
+
+	return c_dif;
+}
+
+/* ******************************************************************
+ *                FUNCIONES AUXILIARES DE LOS ENTEROS
+ * *****************************************************************/
+
+/* Devuelve la primera posición entre bajo (inclusive) y alto (exclusive)
+ * cuyo entero no es menor que x, o alto si no hay ninguna. */
+static size_t enteros_posicion(const uint32_t* enteros, size_t bajo, size_t alto, uint32_t x) {
+
+	while (bajo < alto) {
+
+		size_t medio = bajo + (alto - bajo) / 2;
+
+		if (enteros[medio] < x) bajo = medio + 1;
+		else alto = medio;
+	}
+
+	return bajo;
+}
+
+/* Igual que ordenado_galopar, sobre los 'cant' enteros del arreglo. */
+static size_t enteros_galopar(const uint32_t* enteros, size_t cant, size_t desde, uint32_t x) {
+
+	size_t bajo = desde;
+	size_t salto = 1;
+
+	while (bajo + salto - 1 < cant && enteros[bajo + salto - 1] < x) {
+		bajo += salto;
+		salto *= 2;
+	}
+
+	size_t alto = (bajo + salto - 1 < cant) ? bajo + salto - 1 : cant;
+
+	return enteros_posicion(enteros, bajo, alto, x);
+}
+
+/* Los núcleos reciben dos arreglos ordenados y sin repetidos, a (de na
+ * enteros) y b (de nb), y escriben el resultado, también ordenado, en
+ * 'salida'. Devuelven cuántos enteros escribieron. */
+
+/* Intersección recorriendo a y b a la par, o galopando sobre el más
+ * grande si uno tiene más de UMBRAL_GALOPE veces los enteros del otro. */
+static size_t interseccion_escalar(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* salida) {
+
+	size_t i = 0, j = 0, k = 0;
+
+	if (na * UMBRAL_GALOPE < nb || nb * UMBRAL_GALOPE < na) {
+
+		const uint32_t* chico = (na < nb) ? a : b;
+		const uint32_t* grande = (na < nb) ? b : a;
+		size_t n_chico = (na < nb) ? na : nb;
+		size_t n_grande = (na < nb) ? nb : na;
+
+		for (i = 0; i < n_chico && j < n_grande; i++) {
+
+			j = enteros_galopar(grande, n_grande, j, chico[i]);
+
+			if (j < n_grande && grande[j] == chico[i]) salida[k++] = grande[j++];
+		}
+
+		return k;
+	}
+
+	while (i < na && j < nb) {
+
+		uint32_t x = a[i], y = b[j];
+
+		if (x == y) salida[k++] = x;
+
+		if (x <= y) i++;
+		if (x >= y) j++;
+	}
+
+	return k;
+}
+
+#if defined(__SSSE3__)
+/* Fila m: índices de _mm_shuffle_epi8 que juntan al principio los enteros
+ * de las posiciones cuyo bit está en 1 en m (0x80 deja ceros). */
+static const uint8_t compactar[16][16] = {
+	{ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x04, 0x05, 0x06, 0x07, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80 },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f }
+};
+
+/* Escribe en 'salida' los enteros de v cuyas posiciones marca la máscara. */
+static size_t sse_guardar(__m128i v, int mascara, uint32_t* salida) {
+
+	__m128i indices = _mm_loadu_si128((const __m128i*) compactar[mascara]);
+
+	_mm_storeu_si128((__m128i*) salida, _mm_shuffle_epi8(v, indices));
+
+	return (size_t) __builtin_popcount((unsigned) mascara);
+}
+#endif
+
+#if defined(__AVX2__) && defined(__BMI2__)
+/* Intersección de a 8 por 8: cada bloque de a se compara con las 8
+ * rotaciones del de b, y los iguales se juntan con una permutación que se
+ * arma con pdep y pext a partir de la máscara. Avanza el bloque que
+ * termina en el menor entero, o ambos si terminan en el mismo. */
+static size_t interseccion_simd(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* salida) {
+
+	size_t i = 0, j = 0, k = 0;
+	size_t fin_a = na & ~(size_t) 7, fin_b = nb & ~(size_t) 7;
+	const __m256i rotar = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+
+	if (fin_a > 0 && fin_b > 0) {
+
+		__m256i va = _mm256_loadu_si256((const __m256i*) a);
+		__m256i vb = _mm256_loadu_si256((const __m256i*) b);
+
+		while (true) {
+
+			__m256i iguales = _mm256_cmpeq_epi32(va, vb);
+			__m256i rotado = vb;
+
+			for (int r = 1; r < 8; r++) {
+				rotado = _mm256_permutevar8x32_epi32(rotado, rotar);
+				iguales = _mm256_or_si256(iguales, _mm256_cmpeq_epi32(va, rotado));
+			}
+
+			unsigned mascara = (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(iguales));
+			uint64_t bytes = _pdep_u64(mascara, 0x0101010101010101ULL) * 0xff;
+			uint64_t indices = _pext_u64(0x0706050403020100ULL, bytes);
+			__m256i permutacion = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long) indices));
+
+			_mm256_storeu_si256((__m256i*) (salida + k), _mm256_permutevar8x32_epi32(va, permutacion));
+			k += (size_t) __builtin_popcount(mascara);
+
+			uint32_t max_a = a[i + 7], max_b = b[j + 7];
+
+			if (max_a <= max_b) {
+				i += 8;
+				if (i == fin_a) break;
+				va = _mm256_loadu_si256((const __m256i*) (a + i));
+			}
+
+			if (max_a >= max_b) {
+				j += 8;
+				if (j == fin_b) break;
+				vb = _mm256_loadu_si256((const __m256i*) (b + j));
+			}
+		}
+	}
+
+	return k + interseccion_escalar(a + i, na - i, b + j, nb - j, salida + k);
+}
+#elif defined(__SSSE3__)
+/* Intersección de a 4 por 4 (Schlegel et al.): cada bloque de a se compara
+ * con las 4 rotaciones del de b, y los iguales se juntan con
+ * _mm_shuffle_epi8. Avanza el bloque que termina en el menor entero, o
+ * ambos si terminan en el mismo. */
+static size_t interseccion_simd(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* salida) {
+
+	size_t i = 0, j = 0, k = 0;
+	size_t fin_a = na & ~(size_t) 3, fin_b = nb & ~(size_t) 3;
+
+	if (fin_a > 0 && fin_b > 0) {
+
+		__m128i va = _mm_loadu_si128((const __m128i*) a);
+		__m128i vb = _mm_loadu_si128((const __m128i*) b);
+
+		while (true) {
+
+			__m128i iguales = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi32(va, vb),
+					_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+				_mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+					_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+
+			k += sse_guardar(va, _mm_movemask_ps(_mm_castsi128_ps(iguales)), salida + k);
+
+			uint32_t max_a = a[i + 3], max_b = b[j + 3];
+
+			if (max_a <= max_b) {
+				i += 4;
+				if (i == fin_a) break;
+				va = _mm_loadu_si128((const __m128i*) (a + i));
+			}
+
+			if (max_a >= max_b) {
+				j += 4;
+				if (j == fin_b) break;
+				vb = _mm_loadu_si128((const __m128i*) (b + j));
+			}
+		}
+	}
+
+	return k + interseccion_escalar(a + i, na - i, b + j, nb - j, salida + k);
+}
+#endif
+
+/* Intersección: galopa si los tamaños son muy distintos y, si no, usa el
+ * núcleo vectorial que permita el procesador. */
+static size_t interseccion_enteros(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* salida) {
+
+#if (defined(__AVX2__) && defined(__BMI2__)) || defined(__SSSE3__)
+	if (na * UMBRAL_GALOPE >= nb && nb * UMBRAL_GALOPE >= na)
+		return interseccion_simd(a, na, b, nb, salida);
+#endif
+
+	return interseccion_escalar(a, na, b, nb, salida);
+}
+
+/* Unión recorriendo a y b a la par. */
+static size_t union_escalar(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* salida) {
+
+	size_t i = 0, j = 0, k = 0;
+
+	while (i < na && j < nb) {
+
+		uint32_t x = a[i], y = b[j];
+
+		salida[k++] = (x <= y) ? x : y;
+
+		if (x <= y) i++;
+		if (x >= y) j++;
+	}
+
+	memcpy(salida + k, a + i, (na - i) * sizeof(uint32_t));
+	k += na - i;
+	memcpy(salida + k, b + j, (nb - j) * sizeof(uint32_t));
+	k += nb - j;
+
+	return k;
+}
+
+#if defined(__SSE4_1__)
+/* Red de mezcla de dos vectores ordenados: deja los 4 menores, ordenados,
+ * en *menores y los 4 mayores en *mayores. */
+static void sse_mezclar(__m128i* menores, __m128i* mayores) {
+
+	__m128i minimo = _mm_min_epu32(*menores, *mayores);
+	__m128i maximo = _mm_max_epu32(*menores, *mayores);
+
+	for (int r = 0; r < 3; r++) {
+		minimo = _mm_alignr_epi8(minimo, minimo, 4);
+		__m128i nuevo_minimo = _mm_min_epu32(minimo, maximo);
+		maximo = _mm_max_epu32(minimo, maximo);
+		minimo = nuevo_minimo;
+	}
+
+	*menores = _mm_alignr_epi8(minimo, minimo, 4);
+	*mayores = maximo;
+}
+
+/* Escribe los enteros de v (ordenado) que no repiten al anterior, que es
+ * el último de 'previo' para el primero. */
+static size_t sse_guardar_unicos(__m128i previo, __m128i v, uint32_t* salida) {
+
+	__m128i corrido = _mm_alignr_epi8(v, previo, 12);
+	int repetidos = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(corrido, v)));
+
+	return sse_guardar(v, ~repetidos & 0xf, salida);
+}
+
+/* Unión de a 4: mezcla con una red de min y max el vector de mayores de
+ * la vuelta anterior con el próximo bloque de a o de b (el que empieza en
+ * el menor entero), y escribe los 4 menores sin los repetidos. */
+static size_t union_simd(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* salida) {
+
+	if (na < 4 || nb < 4) return union_escalar(a, na, b, nb, salida);
+
+	size_t i = 4, j = 4, k = 0;
+	size_t fin_a = na & ~(size_t) 3, fin_b = nb & ~(size_t) 3;
+	__m128i menores = _mm_loadu_si128((const __m128i*) a);
+	__m128i mayores = _mm_loadu_si128((const __m128i*) b);
+
+	/* Un "anterior" distinto del primer entero, para no descartarlo. */
+	__m128i previo = _mm_set1_epi32((int) ~((a[0] < b[0]) ? a[0] : b[0]));
+
+	sse_mezclar(&menores, &mayores);
+	k += sse_guardar_unicos(previo, menores, salida + k);
+	previo = menores;
+
+	while (i < fin_a && j < fin_b) {
+
+		if (a[i] <= b[j]) {
+			menores = _mm_loadu_si128((const __m128i*) (a + i));
+			i += 4;
+		} else {
+			menores = _mm_loadu_si128((const __m128i*) (b + j));
+			j += 4;
+		}
+
+		sse_mezclar(&menores, &mayores);
+		k += sse_guardar_unicos(previo, menores, salida + k);
+		previo = menores;
+	}
+
+	/* Quedan los mayores y los restos de a y b: se mezclan los tres sin
+	 * repetir el último entero escrito. */
+	uint32_t resto[4];
+	size_t r = 0;
+
+	_mm_storeu_si128((__m128i*) resto, mayores);
+
+	while (r < 4 || i < na || j < nb) {
+
+		uint32_t x = UINT32_MAX;
+		int origen = -1;
+
+		if (r < 4) { x = resto[r]; origen = 0; }
+		if (i < na && (origen < 0 || a[i] < x)) { x = a[i]; origen = 1; }
+		if (j < nb && (origen < 0 || b[j] < x)) { x = b[j]; origen = 2; }
+
+		if (origen == 0) r++;
+		else if (origen == 1) i++;
+		else j++;
+
+		if (salida[k - 1] != x) salida[k++] = x;
+	}
+
+	return k;
+}
+#endif
+
+/* Unión con el núcleo vectorial que permita el procesador. */
+static size_t union_enteros(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* salida) {
+
+#if defined(__SSE4_1__)
+	return union_simd(a, na, b, nb, salida);
+#else
+	return union_escalar(a, na, b, nb, salida);
+#endif
+}
+
+/* Diferencia a - b recorriendo ambos a la par, o galopando sobre el más
+ * grande si uno tiene más de UMBRAL_GALOPE veces los enteros del otro. */
+static size_t diferencia_enteros(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* salida) {
+
+	size_t i = 0, j = 0, k = 0;
+
+	if (nb * UMBRAL_GALOPE < na) {
+
+		for (j = 0; j < nb; j++) {
+
+			size_t hasta = enteros_galopar(a, na, i, b[j]);
+
+			memcpy(salida + k, a + i, (hasta - i) * sizeof(uint32_t));
+			k += hasta - i;
+			i = (hasta < na && a[hasta] == b[j]) ? hasta + 1 : hasta;
+		}
+
+	} else if (na * UMBRAL_GALOPE < nb) {
+
+		for (; i < na; i++) {
+
+			j = enteros_galopar(b, nb, j, a[i]);
+
+			if (j == nb || b[j] != a[i]) salida[k++] = a[i];
+		}
+
+	} else {
+
+		while (i < na && j < nb) {
+
+			uint32_t x = a[i], y = b[j];
+
+			if (x < y) salida[k++] = x;
+
+			if (x <= y) i++;
+			if (x >= y) j++;
+		}
+	}
+
+	memcpy(salida + k, a + i, (na - i) * sizeof(uint32_t));
+
+	return k + na - i;
+}
+
+static conjunto_t* enteros_union(const conjunto_t* conjunto1, const conjunto_t* conjunto2) {
+
+	conjunto_t* c_union = conjunto_crear_como(conjunto1, conjunto1->cant + conjunto2->cant);
+
+	if (!c_union) return NULL;
+
+	c_union->cant = union_enteros(conjunto1->enteros, conjunto1->cant, conjunto2->enteros, conjunto2->cant, c_union->enteros);
+
+	return c_union;
+}
+
+static conjunto_t* enteros_interseccion(const conjunto_t* conjunto1, const conjunto_t* conjunto2) {
+
+	size_t capacidad = (conjunto1->cant < conjunto2->cant) ? conjunto1->cant : conjunto2->cant;
+	conjunto_t* c_inter = conjunto_crear_como(conjunto1, capacidad);
+
+	if (!c_inter) return NULL;
+
+	c_inter->cant = interseccion_enteros(conjunto1->enteros, conjunto1->cant, conjunto2->enteros, conjunto2->cant, c_inter->enteros);
+
+	return c_inter;
+}
+
+static conjunto_t* enteros_diferencia(const conjunto_t* conjunto1, const conjunto_t* conjunto2) {
+
+	conjunto_t* c_dif = conjunto_crear_como(conjunto1, conjunto1->cant);
+
+	if (!c_dif) return NULL;
+
+	c_dif->cant = diferencia_enteros(conjunto1->enteros, conjunto1->cant, conjunto2->enteros, conjunto2->cant, c_dif->enteros);
+
+	return c_dif;
+}
+
+/* ******************************************************************
+ *                FUNCIONES AUXILIARES DE LOS CONTENEDORES
+ * *****************************************************************/
+
+/* Devuelve la primera posición de los 'largo' valores cuyo valor no es
+ * menor que x, o largo si no hay ninguna. */
+static size_t valores_posicion(const uint16_t* valores, size_t largo, uint16_t x) {
+
+	size_t bajo = 0, alto = largo;
+
+	while (bajo < alto) {
+
+		size_t medio = bajo + (alto - bajo) / 2;
+
+		if (valores[medio] < x) bajo = medio + 1;
+		else alto = medio;
+	}
+
+	return bajo;
+}
+
+static bool mapa_tiene(const uint64_t* palabras, uint16_t x) {
+
+	return (palabras[x >> 6] >> (x & 63)) & 1;
+}
+
+/* Pone en 1 los bits desde inicio hasta fin (inclusive). */
+static void mapa_poner_tramo(uint64_t* palabras, uint32_t inicio, uint32_t fin) {
+
+	size_t primera = inicio >> 6, ultima = fin >> 6;
+	uint64_t mascara_primera = ~(uint64_t) 0 << (inicio & 63);
+	uint64_t mascara_ultima = ~(uint64_t) 0 >> (63 - (fin & 63));
+
+	if (primera == ultima) {
+		palabras[primera] |= mascara_primera & mascara_ultima;
+		return;
+	}
+
+	palabras[primera] |= mascara_primera;
+
+	for (size_t i = primera + 1; i < ultima; i++)
+		palabras[i] = ~(uint64_t) 0;
+
+	palabras[ultima] |= mascara_ultima;
+}
+
+/* Cuenta los tramos de bits en 1 consecutivos: los bits en 1 cuyo
+ * anterior está en 0. */
+static size_t mapa_contar_tramos(const uint64_t* palabras) {
+
+	size_t tramos = 0;
+	uint64_t anterior = 0;
+
+	for (size_t i = 0; i < PALABRAS_MAPA; i++) {
+		tramos += (size_t) __builtin_popcountll(palabras[i] & ~((palabras[i] << 1) | (anterior >> 63)));
+		anterior = palabras[i];
+	}
+
+	return tramos;
+}
+
+/* Escribe en 'valores', de menor a mayor, las posiciones de los bits en 1. */
+static void mapa_a_valores(const uint64_t* palabras, uint16_t* valores) {
+
+	size_t k = 0;
+
+	for (size_t i = 0; i < PALABRAS_MAPA; i++) {
+
+		for (uint64_t palabra = palabras[i]; palabra; palabra &= palabra - 1)
+			valores[k++] = (uint16_t) (i * 64 + (size_t) __builtin_ctzll(palabra));
+	}
+}
+
+/* Escribe en 'valores' los pares (inicio, largo - 1) de los tramos de bits
+ * en 1, saltando de a palabras enteras de ceros o de unos. */
+static void mapa_a_tramos(const uint64_t* palabras, uint16_t* valores) {
+
+	size_t i = 0, k = 0;
+	uint64_t palabra = palabras[0];
+
+	while (true) {
+
+		while (palabra == 0 && i + 1 < PALABRAS_MAPA)
+			palabra = palabras[++i];
+
+		if (palabra == 0) return;
+
+		uint32_t inicio = (uint32_t) (i * 64 + (size_t) __builtin_ctzll(palabra));
+
+		/* Los ceros antes del tramo pasan a 1, para buscar el primer 0 después. */
+		palabra |= palabra - 1;
+
+		while (palabra == ~(uint64_t) 0 && i + 1 < PALABRAS_MAPA)
+			palabra = palabras[++i];
+
+		uint32_t fin = (palabra == ~(uint64_t) 0) ? 65536 : (uint32_t) (i * 64 + (size_t) __builtin_ctzll(~palabra));
+
+		valores[k++] = (uint16_t) inicio;
+		valores[k++] = (uint16_t) (fin - inicio - 1);
+
+		if (fin == 65536) return;
+
+		palabra &= palabra + 1;
+	}
+}
+
+/* Escribe en 'palabras' el mapa de bits de los valores del contenedor. */
+static void contenedor_a_mapa(const contenedor_t* contenedor, uint64_t* palabras) {
+
+	if (contenedor->tipo == CONTENEDOR_MAPA) {
+		memcpy(palabras, contenedor->palabras, BYTES_MAPA);
+		return;
+	}
+
+	memset(palabras, 0, BYTES_MAPA);
+
+	if (contenedor->tipo == CONTENEDOR_ARREGLO) {
+
+		for (size_t i = 0; i < contenedor->largo; i++)
+			palabras[contenedor->valores[i] >> 6] |= (uint64_t) 1 << (contenedor->valores[i] & 63);
+
+		return;
+	}
+
+	for (size_t i = 0; i < contenedor->largo; i++) {
+
+		uint32_t inicio = contenedor->valores[2 * i];
+
+		mapa_poner_tramo(palabras, inicio, inicio + contenedor->valores[2 * i + 1]);
+	}
+}
+
+/* Devuelve el mapa de bits del contenedor: el suyo, si es un mapa, o el
+ * que se escribe en 'auxiliar'. */
+static const uint64_t* contenedor_palabras(const contenedor_t* contenedor, uint64_t* auxiliar) {
+
+	if (contenedor->tipo == CONTENEDOR_MAPA) return contenedor->palabras;
+
+	contenedor_a_mapa(contenedor, auxiliar);
+
+	return auxiliar;
+}
+
+/* Guarda en el contenedor los 'cant' valores del mapa 'palabras', que pasa
+ * a pertenecerle, de la forma que ocupe menos: en tramos (solo si 'tramos'
+ * es verdadero), en un arreglo o en el mismo mapa. No toca el contenedor
+ * si no hay memoria.
+ * Post: devuelve false si no hubo memoria (y libera 'palabras'). */
+static bool contenedor_desde_mapa(contenedor_t* contenedor, uint64_t* palabras, uint32_t cant, bool tramos) {
+
+	size_t cant_tramos = tramos ? mapa_contar_tramos(palabras) : 0;
+
+	/* Un tramo ocupa 2 valores; el mapa, BYTES_MAPA / 2 valores. */
+	if (tramos && cant_tramos * 2 < cant && cant_tramos * 2 < BYTES_MAPA / sizeof(uint16_t)) {
+
+		uint16_t* valores = malloc(cant_tramos * 2 * sizeof(uint16_t));
+
+		if (!valores) {
+			free(palabras);
+			return false;
+		}
+
+		mapa_a_tramos(palabras, valores);
+		free(palabras);
+
+		contenedor->tipo = CONTENEDOR_TRAMOS;
+		contenedor->valores = valores;
+		contenedor->palabras = NULL;
+		contenedor->largo = contenedor->tam = (uint32_t) cant_tramos;
+		contenedor->cant = cant;
+
+		return true;
+	}
+
+	if (cant <= MAX_ARREGLO) {
+
+		uint16_t* valores = malloc((cant ? cant : 1) * sizeof(uint16_t));
+
+		if (!valores) {
+			free(palabras);
+			return false;
+		}
+
+		mapa_a_valores(palabras, valores);
+		free(palabras);
+
+		contenedor->tipo = CONTENEDOR_ARREGLO;
+		contenedor->valores = valores;
+		contenedor->palabras = NULL;
+		contenedor->largo = contenedor->tam = contenedor->cant = cant;
+
+		return true;
+	}
+
+	contenedor->tipo = CONTENEDOR_MAPA;
+	contenedor->valores = NULL;
+	contenedor->palabras = palabras;
+	contenedor->largo = contenedor->tam = 0;
+	contenedor->cant = cant;
+
+	return true;
+}
+
+/* Vuelve a guardar el contenedor, en arreglo o en mapa si 'tramos' es
+ * falso, o de la forma que ocupe menos si es verdadero.
+ * Post: devuelve false si no hubo memoria (el contenedor queda igual). */
+static bool contenedor_reguardar(contenedor_t* contenedor, bool tramos) {
+
+	uint64_t* palabras = malloc(BYTES_MAPA);
+
+	if (!palabras) return false;
+
+	contenedor_a_mapa(contenedor, palabras);
+
+	contenedor_t nuevo = *contenedor;
+
+	if (!contenedor_desde_mapa(&nuevo, palabras, contenedor->cant, tramos)) return false;
+
+	free(contenedor->valores);
+	free(contenedor->palabras);
+	*contenedor = nuevo;
+
+	return true;
+}
+
+static bool contenedor_pertenece(const contenedor_t* contenedor, uint16_t x) {
+
+	if (contenedor->tipo == CONTENEDOR_MAPA) return mapa_tiene(contenedor->palabras, x);
+
+	if (contenedor->tipo == CONTENEDOR_ARREGLO) {
+
+		size_t i = valores_posicion(contenedor->valores, contenedor->largo, x);
+
+		return i < contenedor->largo && contenedor->valores[i] == x;
+	}
+
+	/* Busca el último tramo que empieza en x o antes. */
+	size_t bajo = 0, alto = contenedor->largo;
+
+	while (bajo < alto) {
+
+		size_t medio = bajo + (alto - bajo) / 2;
+
+		if (contenedor->valores[2 * medio] <= x) bajo = medio + 1;
+		else alto = medio;
+	}
+
+	return bajo > 0 && (uint32_t) (x - contenedor->valores[2 * (bajo - 1)]) <= contenedor->valores[2 * (bajo - 1) + 1];
+}
+
+/* Agrega un valor al contenedor. Los tramos pasan a arreglo o a mapa.
+ * Post: devuelve false si ya estaba o si no hubo memoria. */
+static bool contenedor_agregar(contenedor_t* contenedor, uint16_t x) {
+
+	if (contenedor_pertenece(contenedor, x)) return false;
+
+	if (contenedor->tipo == CONTENEDOR_TRAMOS && !contenedor_reguardar(contenedor, false)) return false;
+
+	if (contenedor->tipo == CONTENEDOR_ARREGLO && contenedor->largo == MAX_ARREGLO) {
+
+		uint64_t* palabras = malloc(BYTES_MAPA);
+
+		if (!palabras) return false;
+
+		contenedor_a_mapa(contenedor, palabras);
+		free(contenedor->valores);
+
+		contenedor->tipo = CONTENEDOR_MAPA;
+		contenedor->valores = NULL;
+		contenedor->palabras = palabras;
+		contenedor->largo = contenedor->tam = 0;
+	}
+
+	if (contenedor->tipo == CONTENEDOR_MAPA) {
+
+		contenedor->palabras[x >> 6] |= (uint64_t) 1 << (x & 63);
+		(contenedor->cant)++;
+
+		return true;
+	}
+
+	if (contenedor->largo == contenedor->tam) {
+
+		uint32_t tam_nuevo = (FACTOR * contenedor->tam < MAX_ARREGLO) ? FACTOR * contenedor->tam : MAX_ARREGLO;
+		uint16_t* valores = realloc(contenedor->valores, tam_nuevo * sizeof(uint16_t));
+
+		if (!valores) return false;
+
+		contenedor->valores = valores;
+		contenedor->tam = tam_nuevo;
+	}
+
+	size_t i = valores_posicion(contenedor->valores, contenedor->largo, x);
+
+	memmove(contenedor->valores + i + 1, contenedor->valores + i, (contenedor->largo - i) * sizeof(uint16_t));
+	contenedor->valores[i] = x;
+	(contenedor->largo)++;
+	(contenedor->cant)++;
+
+	return true;
+}
+
+/* Elimina un valor del contenedor. Los tramos pasan a arreglo o a mapa, y
+ * un mapa pasa a arreglo al bajar a la mitad de MAX_ARREGLO (no en
+ * MAX_ARREGLO, para no ir y venir agregando y eliminando el mismo valor).
+ * Post: devuelve false si no estaba o si no hubo memoria. */
+static bool contenedor_eliminar(contenedor_t* contenedor, uint16_t x) {
+
+	if (!contenedor_pertenece(contenedor, x)) return false;
+
+	if (contenedor->tipo == CONTENEDOR_TRAMOS && !contenedor_reguardar(contenedor, false)) return false;
+
+	if (contenedor->tipo == CONTENEDOR_MAPA) {
+
+		contenedor->palabras[x >> 6] &= ~((uint64_t) 1 << (x & 63));
+		(contenedor->cant)--;
+
+		/* Si no hay memoria para el arreglo, sigue siendo un mapa. */
+		if (contenedor->cant <= MAX_ARREGLO / 2) contenedor_reguardar(contenedor, false);
+
+		return true;
+	}
+
+	size_t i = valores_posicion(contenedor->valores, contenedor->largo, x);
+
+	memmove(contenedor->valores + i, contenedor->valores + i + 1, (contenedor->largo - i - 1) * sizeof(uint16_t));
+	(contenedor->largo)--;
+	(contenedor->cant)--;
+
+	return true;
+}
+
+/* Copia en 'destino' el contenedor 'origen'.
+ * Post: devuelve false si no hubo memoria. */
+static bool contenedor_copiar(contenedor_t* destino, const contenedor_t* origen) {
+
+	*destino = *origen;
+
+	if (origen->tipo == CONTENEDOR_MAPA) {
+
+		destino->palabras = malloc(BYTES_MAPA);
+
+		if (!destino->palabras) return false;
+
+		memcpy(destino->palabras, origen->palabras, BYTES_MAPA);
+
+		return true;
+	}
+
+	size_t cant_valores = (origen->tipo == CONTENEDOR_TRAMOS) ? 2 * origen->largo : origen->largo;
+
+	destino->valores = malloc(cant_valores * sizeof(uint16_t));
+
+	if (!destino->valores) return false;
+
+	memcpy(destino->valores, origen->valores, cant_valores * sizeof(uint16_t));
+	destino->tam = origen->largo;
+
+	return true;
+}
+
+/* Guarda en r, como arreglo, los valores del arreglo a que están en b (o
+ * que no están, si 'estan' es falso).
+ * Post: devuelve false si no hubo memoria. */
+static bool arreglo_filtrar(const contenedor_t* a, const contenedor_t* b, bool estan, contenedor_t* r) {
+
+	r->valores = malloc(a->largo * sizeof(uint16_t));
+
+	if (!r->valores) return false;
+
+	size_t k = 0;
+
+	for (size_t i = 0; i < a->largo; i++) {
+
+		if (contenedor_pertenece(b, a->valores[i]) == estan) r->valores[k++] = a->valores[i];
+	}
+
+	r->tipo = CONTENEDOR_ARREGLO;
+	r->palabras = NULL;
+	r->tam = a->largo;
+	r->largo = r->cant = (uint32_t) k;
+
+	return true;
+}
+
+/* Guarda en r, como arreglo, el resultado de operar dos arreglos
+ * recorriéndolos a la par. Pre: el resultado entra en MAX_ARREGLO valores.
+ * Post: devuelve false si no hubo memoria. */
+static bool arreglo_operar(const contenedor_t* a, const contenedor_t* b, operacion_t operacion, contenedor_t* r) {
+
+	size_t tam = (operacion == OPERACION_UNION) ? a->largo + b->largo : a->largo;
+
+	r->valores = malloc(tam * sizeof(uint16_t));
+
+	if (!r->valores) return false;
+
+	size_t i = 0, j = 0, k = 0;
+
+	while (i < a->largo && j < b->largo) {
+
+		uint16_t x = a->valores[i], y = b->valores[j];
+
+		if (operacion == OPERACION_UNION) r->valores[k++] = (x <= y) ? x : y;
+		else if (operacion == OPERACION_INTERSECCION && x == y) r->valores[k++] = x;
+		else if (operacion == OPERACION_DIFERENCIA && x < y) r->valores[k++] = x;
+
+		if (x <= y) i++;
+		if (x >= y) j++;
+	}
+
+	if (operacion != OPERACION_INTERSECCION) {
+		memcpy(r->valores + k, a->valores + i, (a->largo - i) * sizeof(uint16_t));
+		k += a->largo - i;
+	}
+
+	if (operacion == OPERACION_UNION) {
+		memcpy(r->valores + k, b->valores + j, (b->largo - j) * sizeof(uint16_t));
+		k += b->largo - j;
+	}
+
+	r->tipo = CONTENEDOR_ARREGLO;
+	r->palabras = NULL;
+	r->tam = (uint32_t) tam;
+	r->largo = r->cant = (uint32_t) k;
+
+	return true;
+}
+
+/* Guarda en r el resultado de operar dos contenedores de la misma clave
+ * (r puede quedar vacío). Los arreglos chicos se operan valor por valor;
+ * el resto, de a palabras de 64 bits sobre los mapas de bits.
+ * Post: devuelve false si no hubo memoria. */
+static bool contenedor_operar(const contenedor_t* a, const contenedor_t* b, operacion_t operacion, contenedor_t* r) {
+
+	bool a_es_arreglo = (a->tipo == CONTENEDOR_ARREGLO);
+	bool b_es_arreglo = (b->tipo == CONTENEDOR_ARREGLO);
+
+	r->clave = a->clave;
+
+	if (a_es_arreglo && b_es_arreglo && (operacion != OPERACION_UNION || a->cant + b->cant <= MAX_ARREGLO))
+		return arreglo_operar(a, b, operacion, r);
+
+	if (operacion == OPERACION_INTERSECCION && (a_es_arreglo || b_es_arreglo))
+		return a_es_arreglo ? arreglo_filtrar(a, b, true, r) : arreglo_filtrar(b, a, true, r);
+
+	if (operacion == OPERACION_DIFERENCIA && a_es_arreglo)
+		return arreglo_filtrar(a, b, false, r);
+
+	uint64_t auxiliar_a[PALABRAS_MAPA], auxiliar_b[PALABRAS_MAPA];
+	const uint64_t* palabras_a = contenedor_palabras(a, auxiliar_a);
+	const uint64_t* palabras_b = contenedor_palabras(b, auxiliar_b);
+	uint64_t* palabras = malloc(BYTES_MAPA);
+
+	if (!palabras) return false;
+
+	if (operacion == OPERACION_UNION) {
+		for (size_t i = 0; i < PALABRAS_MAPA; i++)
+			palabras[i] = palabras_a[i] | palabras_b[i];
+	} else if (operacion == OPERACION_INTERSECCION) {
+		for (size_t i = 0; i < PALABRAS_MAPA; i++)
+			palabras[i] = palabras_a[i] & palabras_b[i];
+	} else {
+		for (size_t i = 0; i < PALABRAS_MAPA; i++)
+			palabras[i] = palabras_a[i] & ~palabras_b[i];
+	}
+
+	uint32_t cant = 0;
+
+	for (size_t i = 0; i < PALABRAS_MAPA; i++)
+		cant += (uint32_t) __builtin_popcountll(palabras[i]);
+
+	return contenedor_desde_mapa(r, palabras, cant, true);
+}
+
+static void contenedor_destruir(contenedor_t* contenedor) {
+
+	free(contenedor->valores);
+	free(contenedor->palabras);
+}
+
+/* Escribe en 'destino' hasta 'tam' enteros del contenedor, de menor a
+ * mayor. Devuelve cuántos escribió. */
+static size_t contenedor_copiar_enteros(const contenedor_t* contenedor, uint32_t destino[], size_t tam) {
+
+	uint32_t alto = (uint32_t) contenedor->clave << 16;
+	size_t k = 0;
+
+	if (contenedor->tipo == CONTENEDOR_ARREGLO) {
+
+		for (size_t i = 0; i < contenedor->largo && k < tam; i++)
+			destino[k++] = alto | contenedor->valores[i];
+
+	} else if (contenedor->tipo == CONTENEDOR_MAPA) {
+
+		for (size_t i = 0; i < PALABRAS_MAPA && k < tam; i++) {
+
+			for (uint64_t palabra = contenedor->palabras[i]; palabra && k < tam; palabra &= palabra - 1)
+				destino[k++] = alto | (uint32_t) (i * 64 + (size_t) __builtin_ctzll(palabra));
+		}
+
+	} else {
+
+		for (size_t i = 0; i < contenedor->largo && k < tam; i++) {
+
+			uint32_t inicio = contenedor->valores[2 * i];
+
+			for (uint32_t x = inicio; x <= inicio + contenedor->valores[2 * i + 1] && k < tam; x++)
+				destino[k++] = alto | x;
+		}
+	}
+
+	return k;
+}
+
+/* Devuelve los bytes que ocupan los valores del contenedor. */
+static size_t contenedor_memoria(const contenedor_t* contenedor) {
+
+	if (contenedor->tipo == CONTENEDOR_MAPA) return BYTES_MAPA;
+
+	size_t por_lugar = (contenedor->tipo == CONTENEDOR_TRAMOS) ? 2 : 1;
+
+	return contenedor->tam * por_lugar * sizeof(uint16_t);
+}
+
+/* ******************************************************************
+ *                FUNCIONES AUXILIARES DEL MAPA DE BITS
+ * *****************************************************************/
+
+/* Devuelve la primera posición cuyo contenedor no tiene clave menor que
+ * 'clave', o cant_contenedores si no hay ninguna. */
+static size_t bitmap_posicion(const conjunto_t* conjunto, uint16_t clave) {
+
+	size_t bajo = 0, alto = conjunto->cant_contenedores;
+
+	while (bajo < alto) {
+
+		size_t medio = bajo + (alto - bajo) / 2;
+
+		if (conjunto->contenedores[medio].clave < clave) bajo = medio + 1;
+		else alto = medio;
+	}
+
+	return bajo;
+}
+
+/* Devuelve el contenedor de la clave, o NULL si no tiene. */
+static contenedor_t* bitmap_contenedor(const conjunto_t* conjunto, uint16_t clave) {
+
+	size_t i = bitmap_posicion(conjunto, clave);
+
+	if (i == conjunto->cant_contenedores || conjunto->contenedores[i].clave != clave) return NULL;
+
+	return &conjunto->contenedores[i];
+}
+
+static bool bitmap_pertenece(const conjunto_t* conjunto, uint32_t entero) {
+
+	contenedor_t* contenedor = bitmap_contenedor(conjunto, (uint16_t) (entero >> 16));
+
+	return contenedor && contenedor_pertenece(contenedor, (uint16_t) entero);
+}
+
+static bool bitmap_agregar(conjunto_t* conjunto, uint32_t entero) {
+
+	uint16_t clave = (uint16_t) (entero >> 16);
+	size_t i = bitmap_posicion(conjunto, clave);
+
+	if (i < conjunto->cant_contenedores && conjunto->contenedores[i].clave == clave) {
+
+		if (!contenedor_agregar(&conjunto->contenedores[i], (uint16_t) entero)) return false;
+
+		(conjunto->cant)++;
+
+		return true;
+	}
+
+	if (conjunto->cant_contenedores == conjunto->tam) {
+
+		contenedor_t* contenedores = realloc(conjunto->contenedores, FACTOR * conjunto->tam * sizeof(contenedor_t));
+
+		if (!contenedores) return false;
+
+		conjunto->contenedores = contenedores;
+		conjunto->tam *= FACTOR;
+	}
+
+	contenedor_t nuevo = { clave, CONTENEDOR_ARREGLO, 1, 1, TAM_MINIMO_ARREGLO, NULL, NULL };
+
+	nuevo.valores = malloc(TAM_MINIMO_ARREGLO * sizeof(uint16_t));
+
+	if (!nuevo.valores) return false;
+
+	nuevo.valores[0] = (uint16_t) entero;
+
+	memmove(conjunto->contenedores + i + 1, conjunto->contenedores + i, (conjunto->cant_contenedores - i) * sizeof(contenedor_t));
+	conjunto->contenedores[i] = nuevo;
+	(conjunto->cant_contenedores)++;
+	(conjunto->cant)++;
+
+	return true;
+}
+
+static bool bitmap_eliminar(conjunto_t* conjunto, uint32_t entero) {
+
+	size_t i = bitmap_posicion(conjunto, (uint16_t) (entero >> 16));
+
+	if (i == conjunto->cant_contenedores || conjunto->contenedores[i].clave != (uint16_t) (entero >> 16)) return false;
+
+	contenedor_t* contenedor = &conjunto->contenedores[i];
+
+	if (!contenedor_eliminar(contenedor, (uint16_t) entero)) return false;
+
+	(conjunto->cant)--;
+
+	if (contenedor->cant == 0) {
+		contenedor_destruir(contenedor);
+		memmove(conjunto->contenedores + i, conjunto->contenedores + i + 1, (conjunto->cant_contenedores - i - 1) * sizeof(contenedor_t));
+		(conjunto->cant_contenedores)--;
+	}
+
+	return true;
+}
+
+static void bitmap_destruir(conjunto_t* conjunto) {
+
+	for (size_t i = 0; i < conjunto->cant_contenedores; i++)
+		contenedor_destruir(&conjunto->contenedores[i]);
+
+	free(conjunto->contenedores);
+	free(conjunto);
+}
+
+/* Agrega al final un contenedor, que pasa a pertenecerle, o lo destruye si
+ * está vacío. Pre: hay lugar y mantiene el orden de las claves. */
+static void bitmap_anexar(conjunto_t* conjunto, contenedor_t* contenedor) {
+
+	if (contenedor->cant == 0) {
+		contenedor_destruir(contenedor);
+		return;
+	}
+
+	conjunto->contenedores[(conjunto->cant_contenedores)++] = *contenedor;
+	conjunto->cant += contenedor->cant;
+}
+
+/* Opera dos mapas de bits recorriendo sus contenedores a la par: los de
+ * claves que están en uno solo se copian (o no) según la operación, y los
+ * de claves comunes se operan entre sí. */
+static conjunto_t* bitmap_operar(const conjunto_t* conjunto1, const conjunto_t* conjunto2, operacion_t operacion) {
+
+	size_t n1 = conjunto1->cant_contenedores, n2 = conjunto2->cant_contenedores;
+	size_t capacidad = (operacion == OPERACION_UNION) ? n1 + n2 : n1;
+	conjunto_t* resultado = conjunto_crear_como(conjunto1, capacidad);
+
+	if (!resultado) return NULL;
+
+	size_t i = 0, j = 0;
+	bool ok = true;
+
+	while (ok && (i < n1 || j < n2)) {
+
+		contenedor_t nuevo = { 0, CONTENEDOR_ARREGLO, 0, 0, 0, NULL, NULL };
+		const contenedor_t* a = (i < n1) ? &conjunto1->contenedores[i] : NULL;
+		const contenedor_t* b = (j < n2) ? &conjunto2->contenedores[j] : NULL;
+
+		if (a && (!b || a->clave < b->clave)) {
+			if (operacion != OPERACION_INTERSECCION) ok = contenedor_copiar(&nuevo, a);
+			i++;
+		} else if (!a || b->clave < a->clave) {
+			if (operacion == OPERACION_UNION) ok = contenedor_copiar(&nuevo, b);
+			j++;
+		} else {
+			ok = contenedor_operar(a, b, operacion, &nuevo);
+			i++;
+			j++;
+		}
+
+		if (ok) bitmap_anexar(resultado, &nuevo);
+	}
+
+	if (!ok) {
+		bitmap_destruir(resultado);
+		return NULL;
+	}
+
+	return resultado;
+}
+
+/* Opera dos conjuntos de enteros del mismo tipo. */
+static conjunto_t* operar_enteros(const conjunto_t* conjunto1, const conjunto_t* conjunto2, operacion_t operacion) {
+
+	if (conjunto1->tipo != conjunto2->tipo || !es_de_enteros(conjunto1)) return NULL;
+
+	if (conjunto1->tipo == CONJUNTO_BITMAP) return bitmap_operar(conjunto1, conjunto2, operacion);
+
+	if (operacion == OPERACION_UNION) return enteros_union(conjunto1, conjunto2);
+
+	if (operacion == OPERACION_INTERSECCION) return enteros_interseccion(conjunto1, conjunto2);
+
+	return enteros_diferencia(conjunto1, conjunto2);
+}
+
+/* ******************************************************************
+ *                FUNCIONES AUXILIARES DE LAS OPERACIONES PARALELAS
+ * *****************************************************************/
+
+/* Verifica si el dato i de conjunto1 va antes (o junto) que el dato j de
+ * conjunto2 al recorrerlos a la par. */
+static bool va_antes(const conjunto_t* conjunto1, size_t i, const conjunto_t* conjunto2, size_t j) {
+
+	if (conjunto1->tipo == CONJUNTO_ENTEROS) return conjunto1->enteros[i] <= conjunto2->enteros[j];
+
+	return conjunto1->cmp(conjunto1->datos[i], conjunto2->datos[j]) <= 0;
+}
+
+static bool son_iguales(const conjunto_t* conjunto1, size_t i, const conjunto_t* conjunto2, size_t j) {
+
+	if (conjunto1->tipo == CONJUNTO_ENTEROS) return conjunto1->enteros[i] == conjunto2->enteros[j];
+
+	return conjunto1->cmp(conjunto1->datos[i], conjunto2->datos[j]) == 0;
+}
+
+/* Corta el recorrido a la par de ambos conjuntos (merge path) después de
+ * sus primeros 'diagonal' datos: deja en *i cuántos son de conjunto1 y en
+ * *j cuántos de conjunto2. Si el último de conjunto1 es igual al siguiente
+ * de conjunto2, este pasa también al primer tramo, para que cada dato
+ * común quede entero en un tramo. */
+static void cortar_a_la_par(const conjunto_t* conjunto1, const conjunto_t* conjunto2, size_t diagonal, size_t* i, size_t* j) {
+
+	size_t bajo = (diagonal > conjunto2->cant) ? diagonal - conjunto2->cant : 0;
+	size_t alto = (diagonal < conjunto1->cant) ? diagonal : conjunto1->cant;
+
+	while (bajo < alto) {
+
+		size_t medio = bajo + (alto - bajo) / 2;
+
+		if (va_antes(conjunto1, medio, conjunto2, diagonal - medio - 1)) bajo = medio + 1;
+		else alto = medio;
+	}
+
+	*i = bajo;
+	*j = diagonal - bajo;
+
+	if (*i > 0 && *j < conjunto2->cant && son_iguales(conjunto1, *i - 1, conjunto2, *j)) (*j)++;
+}
+
+/* Devuelve cuántos datos puede escribir el trabajo, como mucho. */
+static size_t trabajo_capacidad(const trabajo_t* trabajo) {
+
+	size_t cant1 = trabajo->hasta1 - trabajo->desde1;
+	size_t cant2 = trabajo->hasta2 - trabajo->desde2;
+
+	if (trabajo->operacion == OPERACION_UNION) return cant1 + cant2;
+
+	return (cant1 < cant2) ? cant1 : cant2;
+}
+
+/* Opera el tramo de datos genéricos del trabajo, recorriéndolo a la par.
+ * Los datos comunes se toman de conjunto1. */
+static size_t operar_tramo_ordenado(const trabajo_t* trabajo) {
+
+	const conjunto_t* conjunto1 = trabajo->conjunto1;
+	const conjunto_t* conjunto2 = trabajo->conjunto2;
+	void* *salida = trabajo->resultado->datos + trabajo->salida;
+	size_t i = trabajo->desde1, j = trabajo->desde2, k = 0;
+
+	while (i < trabajo->hasta1 && j < trabajo->hasta2) {
+
+		int comparacion = conjunto1->cmp(conjunto1->datos[i], conjunto2->datos[j]);
+
+		if (trabajo->operacion == OPERACION_UNION) salida[k++] = (comparacion <= 0) ? conjunto1->datos[i] : conjunto2->datos[j];
+		else if (comparacion == 0) salida[k++] = conjunto1->datos[i];
+
+		if (comparacion <= 0) i++;
+		if (comparacion >= 0) j++;
+	}
+
+	if (trabajo->operacion == OPERACION_UNION) {
+		memcpy(salida + k, conjunto1->datos + i, (trabajo->hasta1 - i) * sizeof(void*));
+		k += trabajo->hasta1 - i;
+		memcpy(salida + k, conjunto2->datos + j, (trabajo->hasta2 - j) * sizeof(void*));
+		k += trabajo->hasta2 - j;
+	}
+
+	return k;
+}
+
+static void* operar_tramo(void* dato) {
+
+	trabajo_t* trabajo = dato;
+
+	if (trabajo->resultado->tipo != CONJUNTO_ENTEROS) {
+		trabajo->cant = operar_tramo_ordenado(trabajo);
+		return NULL;
+	}
+
+	const uint32_t* a = trabajo->conjunto1->enteros + trabajo->desde1;
+	const uint32_t* b = trabajo->conjunto2->enteros + trabajo->desde2;
+	size_t na = trabajo->hasta1 - trabajo->desde1;
+	size_t nb = trabajo->hasta2 - trabajo->desde2;
+	uint32_t* salida = trabajo->resultado->enteros + trabajo->salida;
+
+	if (trabajo->operacion == OPERACION_UNION) trabajo->cant = union_enteros(a, na, b, nb, salida);
+	else trabajo->cant = interseccion_enteros(a, na, b, nb, salida);
+
+	return NULL;
+}
+
+/* Opera dos conjuntos ordenados (con la misma cmp) o de enteros en
+ * 'hilos' hilos. Cada trabajo escribe su tramo del resultado en su lugar
+ * (con HOLGURA_SIMD de más, para que los núcleos vectoriales no pisen el
+ * siguiente), y después se corren los tramos hasta dejarlos seguidos. */
+static conjunto_t* operar_en_paralelo(const conjunto_t* conjunto1, const conjunto_t* conjunto2, operacion_t operacion, size_t hilos) {
+
+	trabajo_t* trabajos = malloc(hilos * sizeof(trabajo_t));
+
+	if (!trabajos) return NULL;
+
+	size_t total = conjunto1->cant + conjunto2->cant;
+	size_t capacidad = 0;
+	size_t i = 0, j = 0;
+
+	for (size_t numero = 0; numero < hilos; numero++) {
+
+		trabajo_t* trabajo = &trabajos[numero];
+
+		trabajo->conjunto1 = conjunto1;
+		trabajo->conjunto2 = conjunto2;
+		trabajo->operacion = operacion;
+		trabajo->desde1 = i;
+		trabajo->desde2 = j;
+
+		if (numero == hilos - 1) {
+			i = conjunto1->cant;
+			j = conjunto2->cant;
+		} else {
+			size_t hasta1, hasta2;
+
+			cortar_a_la_par(conjunto1, conjunto2, total / hilos * (numero + 1), &hasta1, &hasta2);
+
+			/* Un dato común que pasó al tramo anterior puede dejar un corte atrás. */
+			if (hasta1 > i) i = hasta1;
+			if (hasta2 > j) j = hasta2;
+		}
+
+		trabajo->hasta1 = i;
+		trabajo->hasta2 = j;
+		trabajo->salida = capacidad;
+		capacidad += trabajo_capacidad(trabajo) + HOLGURA_SIMD;
+	}
+
+	conjunto_t* resultado = conjunto_crear_como(conjunto1, capacidad);
+
+	if (!resultado) {
+		free(trabajos);
+		return NULL;
+	}
+
+	for (size_t numero = 0; numero < hilos; numero++)
+		trabajos[numero].resultado = resultado;
+
+	for (size_t numero = 1; numero < hilos; numero++)
+		trabajos[numero].creado = (pthread_create(&trabajos[numero].hilo, NULL, operar_tramo, &trabajos[numero]) == 0);
+
+	operar_tramo(&trabajos[0]);
+
+	for (size_t numero = 1; numero < hilos; numero++) {
+
+		if (trabajos[numero].creado) pthread_join(trabajos[numero].hilo, NULL);
+		else operar_tramo(&trabajos[numero]);
+	}
+
+	/* El primer tramo ya está en su lugar; el resto se corre hacia atrás. */
+	size_t tam_dato = (resultado->tipo == CONJUNTO_ENTEROS) ? sizeof(uint32_t) : sizeof(void*);
+	char* base = (resultado->tipo == CONJUNTO_ENTEROS) ? (char*) resultado->enteros : (char*) resultado->datos;
+
+	resultado->cant = trabajos[0].cant;
+
+	for (size_t numero = 1; numero < hilos; numero++) {
+
+		memmove(base + resultado->cant * tam_dato, base + trabajos[numero].salida * tam_dato, trabajos[numero].cant * tam_dato);
+		resultado->cant += trabajos[numero].cant;
+	}
+
+	free(trabajos);
+
+	return resultado;
+}
+
+/* Devuelve en cuántos hilos conviene operar los conjuntos: 1 (operarlos
+ * sin hilos) si no son ordenados con la misma cmp ni ambos de enteros, si
+ * son chicos o si uno es tanto más chico que conviene galopar. */
+static size_t hilos_para(const conjunto_t* conjunto1, const conjunto_t* conjunto2, size_t hilos) {
+
+	bool de_enteros = conjunto1->tipo == CONJUNTO_ENTEROS && conjunto2->tipo == CONJUNTO_ENTEROS;
+
+	if (!de_enteros && !ordenados_a_la_par(conjunto1, conjunto2)) return 1;
+
+	if (conviene_galopar(conjunto1, conjunto2) || conviene_galopar(conjunto2, conjunto1)) return 1;
+
+	size_t maximo = (conjunto1->cant + conjunto2->cant) / MIN_DATOS_POR_HILO;
+
+	return (hilos < maximo) ? hilos : ((maximo > 0) ? maximo : 1);
+}
+
+/* ******************************************************************
+ *                FUNCIONES AUXILIARES DE LOS ITERADORES
+ * *****************************************************************/
+
+/* Compara los datos actuales de dos iteradores del mismo tipo de datos. */
+static int iter_comparar(const conjunto_iter_t* iter1, const conjunto_iter_t* iter2) {
+
+	if (iter1->de_enteros) return (iter1->entero > iter2->entero) - (iter1->entero < iter2->entero);
+
+	return iter1->cmp(iter1->actual, iter2->actual);
+}
+
+/* Toma como dato actual el de 'origen'. */
+static void iter_tomar(conjunto_iter_t* iter, const conjunto_iter_t* origen) {
+
+	iter->actual = origen->actual;
+	iter->entero = origen->entero;
+	iter->al_final = false;
+}
+
+/* Busca el menor valor del contenedor que no es menor que 'desde' (que
+ * puede pasar de 16 bits) y deja en *indice su posición en el arreglo o
+ * su tramo. Devuelve false si no hay ninguno. */
+static bool contenedor_siguiente(const contenedor_t* contenedor, uint32_t desde, size_t* indice, uint32_t* valor) {
+
+	if (desde > UINT16_MAX) return false;
+
+	if (contenedor->tipo == CONTENEDOR_ARREGLO) {
+
+		size_t i = valores_posicion(contenedor->valores, contenedor->largo, (uint16_t) desde);
+
+		if (i == contenedor->largo) return false;
+
+		*indice = i;
+		*valor = contenedor->valores[i];
+
+		return true;
+	}
+
+	if (contenedor->tipo == CONTENEDOR_MAPA) {
+
+		size_t i = desde >> 6;
+		uint64_t palabra = contenedor->palabras[i] & (~(uint64_t) 0 << (desde & 63));
+
+		while (palabra == 0) {
+
+			if (++i == PALABRAS_MAPA) return false;
+
+			palabra = contenedor->palabras[i];
+		}
+
+		*valor = (uint32_t) (i * 64 + (size_t) __builtin_ctzll(palabra));
+
+		return true;
+	}
+
+	/* Busca el primer tramo que termina en 'desde' o después. */
+	size_t bajo = 0, alto = contenedor->largo;
+
+	while (bajo < alto) {
+
+		size_t medio = bajo + (alto - bajo) / 2;
+
+		if ((uint32_t) contenedor->valores[2 * medio] + contenedor->valores[2 * medio + 1] < desde) bajo = medio + 1;
+		else alto = medio;
+	}
+
+	if (bajo == contenedor->largo) return false;
+
+	*indice = bajo;
+	*valor = (contenedor->valores[2 * bajo] > desde) ? contenedor->valores[2 * bajo] : desde;
+
+	return true;
+}
+
+/* Deja la hoja de un mapa de bits en su primer entero, desde el valor
+ * 'desde' del contenedor pos, o al final si no quedan. */
+static void hoja_bitmap_ubicar(conjunto_iter_t* iter, uint32_t desde) {
+
+	const conjunto_t* conjunto = iter->conjunto;
+
+	for (; iter->pos < conjunto->cant_contenedores; iter->pos++, desde = 0) {
+
+		const contenedor_t* contenedor = &conjunto->contenedores[iter->pos];
+		uint32_t valor;
+
+		if (contenedor_siguiente(contenedor, desde, &iter->indice, &valor)) {
+			iter->entero = ((uint32_t) contenedor->clave << 16) | valor;
+			iter->al_final = false;
+			return;
+		}
+	}
+
+	iter->al_final = true;
+}
+
+/* Deja la hoja en el dato de la posición pos, o en el siguiente si es
+ * una ranura libre, o al final si no quedan. */
+static void hoja_ubicar(conjunto_iter_t* iter) {
+
+	const conjunto_t* conjunto = iter->conjunto;
+
+	if (conjunto->tipo == CONJUNTO_BITMAP) {
+		hoja_bitmap_ubicar(iter, 0);
+		return;
+	}
+
+	while (conjunto->tipo == CONJUNTO_HASH && iter->pos < conjunto->tam && conjunto->hashes[iter->pos] == 0)
+		(iter->pos)++;
+
+	iter->al_final = (iter->pos >= ((conjunto->tipo == CONJUNTO_HASH) ? conjunto->tam : conjunto->cant));
+
+	if (iter->al_final) return;
+
+	if (conjunto->tipo == CONJUNTO_ENTEROS) iter->entero = conjunto->enteros[iter->pos];
+	else iter->actual = conjunto->datos[iter->pos];
+}
+
+static void hoja_avanzar(conjunto_iter_t* iter) {
+
+	if (iter->conjunto->tipo != CONJUNTO_BITMAP) {
+		(iter->pos)++;
+		hoja_ubicar(iter);
+		return;
+	}
+
+	const contenedor_t* contenedor = &iter->conjunto->contenedores[iter->pos];
+	uint32_t alto = iter->entero & ~(uint32_t) UINT16_MAX;
+	uint32_t bajo = iter->entero & UINT16_MAX;
+
+	if (contenedor->tipo == CONTENEDOR_ARREGLO && iter->indice + 1 < contenedor->largo) {
+		iter->entero = alto | contenedor->valores[++(iter->indice)];
+		return;
+	}
+
+	if (contenedor->tipo == CONTENEDOR_TRAMOS) {
+
+		if (bajo < (uint32_t) contenedor->valores[2 * iter->indice] + contenedor->valores[2 * iter->indice + 1]) {
+			(iter->entero)++;
+			return;
+		}
+
+		if (iter->indice + 1 < contenedor->largo) {
+			iter->entero = alto | contenedor->valores[2 * ++(iter->indice)];
+			return;
+		}
+	}
+
+	if (contenedor->tipo == CONTENEDOR_MAPA) {
+		hoja_bitmap_ubicar(iter, bajo + 1);
+		return;
+	}
+
+	(iter->pos)++;
+	hoja_bitmap_ubicar(iter, 0);
+}
+
+/* Avanza la hoja (ordenada) hasta el primer dato que no es menor que el
+ * actual de 'objetivo', galopando. */
+static void hoja_buscar(conjunto_iter_t* iter, const conjunto_iter_t* objetivo) {
+
+	const conjunto_t* conjunto = iter->conjunto;
+
+	if (conjunto->tipo == CONJUNTO_ORDENADO) {
+		iter->pos = ordenado_galopar(conjunto, iter->pos, objetivo->actual);
+		hoja_ubicar(iter);
+		return;
+	}
+
+	if (conjunto->tipo == CONJUNTO_ENTEROS) {
+		iter->pos = enteros_galopar(conjunto->enteros, conjunto->cant, iter->pos, objetivo->entero);
+		hoja_ubicar(iter);
+		return;
+	}
+
+	uint16_t clave = (uint16_t) (objetivo->entero >> 16);
+
+	if (conjunto->contenedores[iter->pos].clave < clave) iter->pos = bitmap_posicion(conjunto, clave);
+
+	if (iter->pos < conjunto->cant_contenedores && conjunto->contenedores[iter->pos].clave == clave)
+		hoja_bitmap_ubicar(iter, objetivo->entero & UINT16_MAX);
+	else
+		hoja_bitmap_ubicar(iter, 0);
+}
+
+static void iter_avanzar(conjunto_iter_t* iter);
+
+/* Avanza el iterador (ordenado) hasta el primer dato que no es menor que
+ * el actual de 'objetivo', o solo lo ubica si 'objetivo' es NULL: una
+ * combinación busca en sus iteradores y, a partir de ellos, su actual. */
+static void iter_buscar(conjunto_iter_t* iter, const conjunto_iter_t* objetivo) {
+
+	if (objetivo && (iter->al_final || iter_comparar(iter, objetivo) >= 0)) return;
+
+	if (iter->tipo == ITER_CONJUNTO) {
+		hoja_buscar(iter, objetivo);
+		return;
+	}
+
+	conjunto_iter_t* izq = iter->izq;
+	conjunto_iter_t* der = iter->der;
+
+	if (objetivo) {
+		iter_buscar(izq, objetivo);
+		if (iter->tipo != ITER_DIFERENCIA) iter_buscar(der, objetivo);
+	}
+
+	while (true) {
+
+		if (izq->al_final && (der->al_final || iter->tipo == ITER_INTERSECCION || iter->tipo == ITER_DIFERENCIA)) {
+			iter->al_final = true;
+			return;
+		}
+
+		if (iter->tipo == ITER_INTERSECCION) {
+
+			if (der->al_final) {
+				iter->al_final = true;
+				return;
+			}
+
+			int comparacion = iter_comparar(izq, der);
+
+			if (comparacion == 0) {
+				iter_tomar(iter, izq);
+				return;
+			}
+
+			if (comparacion < 0) iter_buscar(izq, der);
+			else iter_buscar(der, izq);
+
+			continue;
+		}
+
+		if (iter->tipo == ITER_DIFERENCIA) {
+
+			iter_buscar(der, izq);
+
+			if (der->al_final || iter_comparar(izq, der) != 0) {
+				iter_tomar(iter, izq);
+				return;
+			}
+
+			iter_avanzar(izq);
+			continue;
+		}
+
+		int comparacion = izq->al_final ? 1 : (der->al_final ? -1 : iter_comparar(izq, der));
+
+		/* En la diferencia simétrica se saltean los comunes. */
+		if (comparacion == 0 && iter->tipo == ITER_DIFERENCIA_SIMETRICA) {
+			iter_avanzar(izq);
+			iter_avanzar(der);
+			continue;
+		}
+
+		iter_tomar(iter, (comparacion <= 0) ? izq : der);
+
+		return;
+	}
+}
+
+/* Avanza al dato siguiente. Pre: el iterador no está al final. */
+static void iter_avanzar(conjunto_iter_t* iter) {
+
+	if (iter->tipo == ITER_CONJUNTO) {
+		hoja_avanzar(iter);
+		return;
+	}
+
+	conjunto_iter_t* izq = iter->izq;
+	conjunto_iter_t* der = iter->der;
+
+	/* Avanzan los iteradores cuyo actual es el de la combinación. */
+	bool avanzar_izq = !izq->al_final && iter_comparar(izq, iter) == 0;
+	bool avanzar_der = iter->tipo != ITER_DIFERENCIA && !der->al_final && iter_comparar(der, iter) == 0;
+
+	if (avanzar_izq) iter_avanzar(izq);
+	if (avanzar_der) iter_avanzar(der);
+
+	iter_buscar(iter, NULL);
+}
+
+static void iter_destruir(conjunto_iter_t* iter) {
+
+	if (iter->tipo != ITER_CONJUNTO) {
+		iter_destruir(iter->izq);
+		iter_destruir(iter->der);
+	}
+
+	free(iter);
+}
+
+/* Crea la combinación de dos iteradores, que pasan a pertenecerle.
+ * Post: devuelve NULL (y destruye los iteradores) si alguno es NULL, si
+ * no recorren en orden los mismos datos o si no hubo memoria. */
+static conjunto_iter_t* iter_combinar(iter_tipo_t tipo, conjunto_iter_t* izq, conjunto_iter_t* der) {
+
+	conjunto_iter_t* iter = NULL;
+
+	if (izq && der && izq->ordenado && der->ordenado && izq->de_enteros == der->de_enteros && izq->cmp == der->cmp)
+		iter = malloc(sizeof(conjunto_iter_t));
+
+	if (!iter) {
+		if (izq) iter_destruir(izq);
+		if (der) iter_destruir(der);
+		return NULL;
+	}
+
+	iter->tipo = tipo;
+	iter->conjunto = NULL;
+	iter->izq = izq;
+	iter->der = der;
+	iter->cmp = izq->cmp;
+	iter->de_enteros = izq->de_enteros;
+	iter->ordenado = true;
+	iter->actual = NULL;
+	iter->entero = 0;
+
+	iter_buscar(iter, NULL);
+
+	return iter;
+}
+
+/* Agrega un dato al final del conjunto, agrandándolo si hace falta.
+ * Devuelve false si no hubo memoria. */
+static bool conjunto_anexar(conjunto_t* conjunto, void* dato, uint32_t entero) {
+
+	if (conjunto->cant == conjunto->tam) {
+
+		if (conjunto->tipo != CONJUNTO_ENTEROS) {
 
-typedef void (*destruir_dato_t) (void *);
+			if (!redimensionar_conjunto(conjunto, FACTOR * conjunto->tam)) return false;
 
-typedef struct conjunto {
-	void* *datos;
-	size_t cant;
-	size_t tam;
-	cmp_func_t cmp;
-	destruir_dato_t destruir_dato;
-} conjunto_t;
+		} else {
 
-/* ******************************************************************
- *                       FUNCIONES AUXILIARES
- * *****************************************************************/
+			uint32_t* enteros_nuevo = realloc(conjunto->enteros, (FACTOR * conjunto->tam + HOLGURA_SIMD) * sizeof(uint32_t));
 
-/* Redimensiona el conjunto. */
-static bool redimensionar_conjunto(conjunto_t* conjunto, size_t tam_nuevo) {
+			if (!enteros_nuevo) return false;
 
-	void* datos_nuevo = realloc(conjunto->datos, tam_nuevo * sizeof(void*));
+			conjunto->enteros = enteros_nuevo;
+			conjunto->tam *= FACTOR;
+		}
+	}
 
-	if (!datos_nuevo) return false;
+	if (conjunto->tipo == CONJUNTO_ENTEROS) conjunto->enteros[(conjunto->cant)++] = entero;
+	else conjunto->datos[(conjunto->cant)++] = dato;
 
-	conjunto->datos = datos_nuevo;
-	conjunto->tam = tam_nuevo;
-	
 	return true;
 }
 
@@ -63,29 +2320,125 @@ conjunto_t* conjunto_crear(int tamanio, cmp_func_t cmp, destruir_dato_t destruir
 	conjunto->cant = 0;
 	conjunto->cmp = cmp;
 	conjunto->destruir_dato = destruir_dato;
+	conjunto->tipo = CONJUNTO_ARREGLO;
+	conjunto->fhash = NULL;
+	conjunto->hashes = NULL;
+	conjunto->enteros = NULL;
+	conjunto->contenedores = NULL;
+	conjunto->cant_contenedores = 0;
+
+	return conjunto;
+}
+
+/* Crea un conjunto guardado en una tabla de hash, con lugar para tamanio
+   datos. Devuelve un puntero a NULL en caso de error. */
+conjunto_t* conjunto_crear_hash(int tamanio, cmp_func_t cmp, conjunto_hash_func_t fhash, destruir_dato_t destruir_dato) {
+
+	if (tamanio <= 0 || !fhash) return NULL;
+
+	conjunto_t modelo = { NULL, 0, 0, cmp, destruir_dato, CONJUNTO_HASH, fhash, NULL, NULL, NULL, 0 };
+
+	return conjunto_crear_como(&modelo, (size_t) tamanio);
+}
+
+/* Crea un conjunto de tamaño tam que mantiene sus datos ordenados según cmp.
+   Devuelve un puntero a NULL en caso de error. */
+conjunto_t* conjunto_crear_ordenado(int tamanio, cmp_func_t cmp, destruir_dato_t destruir_dato) {
+
+	conjunto_t* conjunto = conjunto_crear(tamanio, cmp, destruir_dato);
+
+	if (conjunto) conjunto->tipo = CONJUNTO_ORDENADO;
 
 	return conjunto;
 }
 
+/* Crea un conjunto de enteros sin signo de 32 bits, con lugar para
+   tamanio enteros. Devuelve un puntero a NULL en caso de error. */
+conjunto_t* conjunto_crear_enteros(int tamanio) {
+
+	if (tamanio <= 0) return NULL;
+
+	conjunto_t modelo = { NULL, 0, 0, NULL, NULL, CONJUNTO_ENTEROS, NULL, NULL, NULL, NULL, 0 };
+
+	return conjunto_crear_como(&modelo, (size_t) tamanio);
+}
+
+/* Crea un conjunto de enteros sin signo de 32 bits guardado como mapa de
+   bits comprimido. Devuelve un puntero a NULL en caso de error. */
+conjunto_t* conjunto_crear_bitmap(void) {
+
+	conjunto_t modelo = { NULL, 0, 0, NULL, NULL, CONJUNTO_BITMAP, NULL, NULL, NULL, NULL, 0 };
+
+	return conjunto_crear_como(&modelo, 1);
+}
+
 /* Devuelve verdadero en caso de que el dato pertenezca al conjunto,
    falso en caso contrario. */
 bool conjunto_pertenece(conjunto_t* conjunto, void* dato) {
 
-	if (!conjunto) return false;
-	
+	if (!conjunto || es_de_enteros(conjunto)) return false;
+
+	if (conjunto->tipo == CONJUNTO_HASH) {
+
+		uint64_t h = hash_dato(conjunto, dato);
+
+		return conjunto->hashes[tabla_buscar(conjunto, dato, h)] != 0;
+	}
+
+	if (conjunto->tipo == CONJUNTO_ORDENADO)
+		return ordenado_es(conjunto, ordenado_posicion(conjunto, 0, conjunto->cant, dato), dato);
+
 	for (size_t i = 0; i < conjunto->cant; i++) {
-		
+
 		if (conjunto->cmp(conjunto->datos[i], dato) == 0) return true;
 	}
-	
+
 	return false;
 }
 
 /* Agrega un dato al conjunto. Devuelve false en caso de error. */
 bool conjunto_agregar(conjunto_t* conjunto, void* dato) {
 
-	if (!conjunto) return false;
-	
+	if (!conjunto || es_de_enteros(conjunto)) return false;
+
+	if (conjunto->tipo == CONJUNTO_HASH) {
+
+		uint64_t h = hash_dato(conjunto, dato);
+		size_t i = tabla_buscar(conjunto, dato, h);
+
+		if (conjunto->hashes[i] != 0) return false;
+
+		if ((conjunto->cant + 1) * OCUPACION_MAXIMA_DEN > conjunto->tam * OCUPACION_MAXIMA_NUM) {
+
+			if (!tabla_redimensionar(conjunto, FACTOR * conjunto->tam)) return false;
+
+			i = tabla_buscar(conjunto, dato, h);
+		}
+
+		conjunto->hashes[i] = h;
+		conjunto->datos[i] = dato;
+		(conjunto->cant)++;
+
+		return true;
+	}
+
+	if (conjunto->tipo == CONJUNTO_ORDENADO) {
+
+		size_t i = ordenado_posicion(conjunto, 0, conjunto->cant, dato);
+
+		if (ordenado_es(conjunto, i, dato)) return false;
+
+		if ((conjunto->tam == conjunto->cant) &&
+			!redimensionar_conjunto(conjunto, FACTOR * conjunto->tam))
+			return false;
+
+		memmove(conjunto->datos + i + 1, conjunto->datos + i, (conjunto->cant - i) * sizeof(void*));
+		conjunto->datos[i] = dato;
+		(conjunto->cant)++;
+
+		return true;
+	}
+
 	if (conjunto_pertenece(conjunto, dato)) return false;
 
 	if ((conjunto->tam == conjunto->cant) &&
@@ -101,9 +2454,43 @@ bool conjunto_agregar(conjunto_t* conjunto, void* dato) {
 /* Elimina un dato del conjunto. */
 bool conjunto_eliminar(conjunto_t* conjunto, void* dato) {
 
-	if (!conjunto) return false;
+	if (!conjunto || es_de_enteros(conjunto)) return false;
+
+	if (conjunto->tipo == CONJUNTO_HASH) {
+
+		size_t i = tabla_buscar(conjunto, dato, hash_dato(conjunto, dato));
+
+		if (conjunto->hashes[i] == 0) return false;
+
+		void* guardado = conjunto->datos[i];
+
+		tabla_liberar(conjunto, i);
+		(conjunto->cant)--;
+
+		if (conjunto->destruir_dato)
+			conjunto->destruir_dato(guardado);
+
+		return true;
+	}
+
+	if (conjunto->tipo == CONJUNTO_ORDENADO) {
 
-	for (size_t i = 0; i < conjunto->tam; i++) {
+		size_t i = ordenado_posicion(conjunto, 0, conjunto->cant, dato);
+
+		if (!ordenado_es(conjunto, i, dato)) return false;
+
+		void* guardado = conjunto->datos[i];
+
+		memmove(conjunto->datos + i, conjunto->datos + i + 1, (conjunto->cant - i - 1) * sizeof(void*));
+		(conjunto->cant)--;
+
+		if (conjunto->destruir_dato)
+			conjunto->destruir_dato(guardado);
+
+		return true;
+	}
+
+	for (size_t i = 0; i < conjunto->cant; i++) {
 
 		if (conjunto->cmp(conjunto->datos[i], dato) == 0) {
 
@@ -123,25 +2510,166 @@ bool conjunto_eliminar(conjunto_t* conjunto, void* dato) {
 	return false;
 }
 
+/* Devuelve verdadero si el entero pertenece al conjunto de enteros. */
+bool conjunto_pertenece_entero(conjunto_t* conjunto, uint32_t entero) {
+
+	if (!conjunto) return false;
+
+	if (conjunto->tipo == CONJUNTO_BITMAP) return bitmap_pertenece(conjunto, entero);
+
+	if (conjunto->tipo != CONJUNTO_ENTEROS) return false;
+
+	size_t i = enteros_posicion(conjunto->enteros, 0, conjunto->cant, entero);
+
+	return i < conjunto->cant && conjunto->enteros[i] == entero;
+}
+
+/* Agrega un entero al conjunto de enteros. Devuelve false si ya estaba o
+   en caso de error. */
+bool conjunto_agregar_entero(conjunto_t* conjunto, uint32_t entero) {
+
+	if (!conjunto) return false;
+
+	if (conjunto->tipo == CONJUNTO_BITMAP) return bitmap_agregar(conjunto, entero);
+
+	if (conjunto->tipo != CONJUNTO_ENTEROS) return false;
+
+	size_t i = enteros_posicion(conjunto->enteros, 0, conjunto->cant, entero);
+
+	if (i < conjunto->cant && conjunto->enteros[i] == entero) return false;
+
+	if (conjunto->tam == conjunto->cant) {
+
+		uint32_t* enteros_nuevo = realloc(conjunto->enteros, (FACTOR * conjunto->tam + HOLGURA_SIMD) * sizeof(uint32_t));
+
+		if (!enteros_nuevo) return false;
+
+		conjunto->enteros = enteros_nuevo;
+		conjunto->tam *= FACTOR;
+	}
+
+	memmove(conjunto->enteros + i + 1, conjunto->enteros + i, (conjunto->cant - i) * sizeof(uint32_t));
+	conjunto->enteros[i] = entero;
+	(conjunto->cant)++;
+
+	return true;
+}
+
+/* Elimina un entero del conjunto de enteros. */
+bool conjunto_eliminar_entero(conjunto_t* conjunto, uint32_t entero) {
+
+	if (!conjunto) return false;
+
+	if (conjunto->tipo == CONJUNTO_BITMAP) return bitmap_eliminar(conjunto, entero);
+
+	if (conjunto->tipo != CONJUNTO_ENTEROS) return false;
+
+	size_t i = enteros_posicion(conjunto->enteros, 0, conjunto->cant, entero);
+
+	if (i == conjunto->cant || conjunto->enteros[i] != entero) return false;
+
+	memmove(conjunto->enteros + i, conjunto->enteros + i + 1, (conjunto->cant - i - 1) * sizeof(uint32_t));
+	(conjunto->cant)--;
+
+	return true;
+}
+
+/* Copia en 'destino', de menor a mayor, hasta tam enteros del conjunto de
+   enteros. Devuelve cuántos copió. */
+size_t conjunto_copiar_enteros(conjunto_t* conjunto, uint32_t destino[], size_t tam) {
+
+	if (!conjunto) return 0;
+
+	if (conjunto->tipo == CONJUNTO_BITMAP) {
+
+		size_t k = 0;
+
+		for (size_t i = 0; i < conjunto->cant_contenedores && k < tam; i++)
+			k += contenedor_copiar_enteros(&conjunto->contenedores[i], destino + k, tam - k);
+
+		return k;
+	}
+
+	if (conjunto->tipo != CONJUNTO_ENTEROS) return 0;
+
+	size_t cantidad = (conjunto->cant < tam) ? conjunto->cant : tam;
+
+	memcpy(destino, conjunto->enteros, cantidad * sizeof(uint32_t));
+
+	return cantidad;
+}
+
+/* Devuelve la cantidad de datos del conjunto. */
+size_t conjunto_cantidad(conjunto_t* conjunto) {
+
+	return conjunto ? conjunto->cant : 0;
+}
+
+/* Vuelve a guardar cada contenedor de un mapa de bits de la forma que
+   ocupe menos, incluidos los tramos de enteros consecutivos. Devuelve
+   false en caso de error. */
+bool conjunto_optimizar_bitmap(conjunto_t* conjunto) {
+
+	if (!conjunto || conjunto->tipo != CONJUNTO_BITMAP) return false;
+
+	for (size_t i = 0; i < conjunto->cant_contenedores; i++) {
+
+		if (!contenedor_reguardar(&conjunto->contenedores[i], true)) return false;
+	}
+
+	return true;
+}
+
+/* Devuelve los bytes que ocupa el conjunto, sin contar los datos a los que
+   apuntan sus punteros. */
+size_t conjunto_memoria(conjunto_t* conjunto) {
+
+	if (!conjunto) return 0;
+
+	size_t memoria = sizeof(conjunto_t);
+
+	if (conjunto->tipo == CONJUNTO_BITMAP) {
+
+		memoria += conjunto->tam * sizeof(contenedor_t);
+
+		for (size_t i = 0; i < conjunto->cant_contenedores; i++)
+			memoria += contenedor_memoria(&conjunto->contenedores[i]);
+
+		return memoria;
+	}
+
+	if (conjunto->tipo == CONJUNTO_ENTEROS) return memoria + (conjunto->tam + HOLGURA_SIMD) * sizeof(uint32_t);
+
+	if (conjunto->tipo == CONJUNTO_HASH) memoria += conjunto->tam * sizeof(uint64_t);
+
+	return memoria + conjunto->tam * sizeof(void*);
+}
+
 /* Devuelve la unión de dos conjuntos en un conjunto nuevo.
    Devueve NULL en caso de error. */
 conjunto_t* conjunto_union(conjunto_t* conjunto1, conjunto_t* conjunto2) {
 
 	if (!conjunto1 || !conjunto2) return NULL;
 
-	conjunto_t* c_union = conjunto_crear(conjunto1->tam + conjunto2->tam, conjunto1->cmp, conjunto1->destruir_dato);
+	if (es_de_enteros(conjunto1) || es_de_enteros(conjunto2))
+		return operar_enteros(conjunto1, conjunto2, OPERACION_UNION);
+
+	if (ordenados_a_la_par(conjunto1, conjunto2)) return ordenado_union(conjunto1, conjunto2);
+
+	conjunto_t* c_union = conjunto_crear_como(conjunto1, conjunto1->cant + conjunto2->cant);
 
 	if (!c_union) return NULL;
 
-	for (size_t i = 0; i < conjunto1->tam; i++) {
-		
-		conjunto_agregar(c_union, conjunto1->datos[i]);
+	for (size_t i = 0; i < conjunto_posiciones(conjunto1); i++) {
+
+		if (conjunto_ocupada(conjunto1, i))
+			conjunto_agregar(c_union, conjunto1->datos[i]);
 	}
 
-	for (size_t i = 0; i < conjunto2->tam; i++) {
-		
-		if (!conjunto_pertenece(conjunto1, conjunto2->datos[i])) {
-			
+	for (size_t i = 0; i < conjunto_posiciones(conjunto2); i++) {
+
+		if (conjunto_ocupada(conjunto2, i) && !conjunto_pertenece(conjunto1, conjunto2->datos[i])) {
+
 			conjunto_agregar(c_union, conjunto2->datos[i]);
 		}
 	}
@@ -155,14 +2683,19 @@ conjunto_t* conjunto_interseccion(conjunto_t* conjunto1, conjunto_t* conjunto2)
 
 	if (!conjunto1 || !conjunto2) return NULL;
 
-	conjunto_t* c_inter = conjunto_crear(conjunto1->tam, conjunto1->cmp, conjunto1->destruir_dato);
-	
+	if (es_de_enteros(conjunto1) || es_de_enteros(conjunto2))
+		return operar_enteros(conjunto1, conjunto2, OPERACION_INTERSECCION);
+
+	if (ordenados_a_la_par(conjunto1, conjunto2)) return ordenado_interseccion(conjunto1, conjunto2);
+
+	conjunto_t* c_inter = conjunto_crear_como(conjunto1, conjunto1->cant);
+
 	if (!c_inter) return NULL;
-	
-	for (size_t i = 0; i < conjunto1->tam; i++) {
-		
-		if (conjunto_pertenece(conjunto2, conjunto1->datos[i])) {
-			
+
+	for (size_t i = 0; i < conjunto_posiciones(conjunto1); i++) {
+
+		if (conjunto_ocupada(conjunto1, i) && conjunto_pertenece(conjunto2, conjunto1->datos[i])) {
+
 			conjunto_agregar(c_inter, conjunto1->datos[i]);
 		}
 	}
@@ -170,17 +2703,191 @@ conjunto_t* conjunto_interseccion(conjunto_t* conjunto1, conjunto_t* conjunto2)
 	return c_inter;
 }
 
+/* Devuelve la diferencia entre dos conjuntos en un conjunto nuevo.
+   Devueve NULL en caso de error. */
+conjunto_t* conjunto_diferencia(conjunto_t* conjunto1, conjunto_t* conjunto2) {
+
+	if (!conjunto1 || !conjunto2) return NULL;
+
+	if (es_de_enteros(conjunto1) || es_de_enteros(conjunto2))
+		return operar_enteros(conjunto1, conjunto2, OPERACION_DIFERENCIA);
+
+	if (ordenados_a_la_par(conjunto1, conjunto2)) return ordenado_diferencia(conjunto1, conjunto2);
+
+	conjunto_t* c_dif = conjunto_crear_como(conjunto1, conjunto1->cant);
+
+	if (!c_dif) return NULL;
+
+	for (size_t i = 0; i < conjunto_posiciones(conjunto1); i++) {
+
+		if (conjunto_ocupada(conjunto1, i) && !conjunto_pertenece(conjunto2, conjunto1->datos[i])) {
+
+			conjunto_agregar(c_dif, conjunto1->datos[i]);
+		}
+	}
+
+	return c_dif;
+}
+
+/* Devuelve la unión de dos conjuntos en un conjunto nuevo, repartiendo
+   el trabajo en hasta 'hilos' hilos. Devueve NULL en caso de error. */
+conjunto_t* conjunto_union_paralela(conjunto_t* conjunto1, conjunto_t* conjunto2, size_t hilos) {
+
+	if (!conjunto1 || !conjunto2) return NULL;
+
+	hilos = hilos_para(conjunto1, conjunto2, hilos);
+
+	if (hilos <= 1) return conjunto_union(conjunto1, conjunto2);
+
+	return operar_en_paralelo(conjunto1, conjunto2, OPERACION_UNION, hilos);
+}
+
+/* Devuelve la intersección de dos conjuntos en un conjunto nuevo,
+   repartiendo el trabajo en hasta 'hilos' hilos. Devueve NULL en caso de
+   error. */
+conjunto_t* conjunto_interseccion_paralela(conjunto_t* conjunto1, conjunto_t* conjunto2, size_t hilos) {
+
+	if (!conjunto1 || !conjunto2) return NULL;
+
+	hilos = hilos_para(conjunto1, conjunto2, hilos);
+
+	if (hilos <= 1) return conjunto_interseccion(conjunto1, conjunto2);
+
+	return operar_en_paralelo(conjunto1, conjunto2, OPERACION_INTERSECCION, hilos);
+}
+
 /* Destruye el conjunto*/
 void conjunto_destruir(conjunto_t* conjunto) {
 
+	if (conjunto->tipo == CONJUNTO_BITMAP) {
+		bitmap_destruir(conjunto);
+		return;
+	}
+
 	if (conjunto->destruir_dato) {
 
-		for (size_t i = 0; i < conjunto->cant; i++) {
+		for (size_t i = 0; i < conjunto_posiciones(conjunto); i++) {
 
-			conjunto->destruir_dato(conjunto->datos[i]);
+			if (conjunto_ocupada(conjunto, i))
+				conjunto->destruir_dato(conjunto->datos[i]);
 		}
 	}
 
+	free(conjunto->enteros);
+	free(conjunto->hashes);
 	free(conjunto->datos);
 	free(conjunto);
 }
+
+/* ******************************************************************
+ *                    PRIMITIVAS DEL ITERADOR
+ * *****************************************************************/
+
+/* Crea un iterador que recorre el conjunto. */
+conjunto_iter_t* conjunto_iter_crear(conjunto_t* conjunto) {
+
+	if (!conjunto) return NULL;
+
+	conjunto_iter_t* iter = malloc(sizeof(conjunto_iter_t));
+
+	if (!iter) return NULL;
+
+	iter->tipo = ITER_CONJUNTO;
+	iter->conjunto = conjunto;
+	iter->izq = NULL;
+	iter->der = NULL;
+	iter->cmp = conjunto->cmp;
+	iter->de_enteros = es_de_enteros(conjunto);
+	iter->ordenado = (conjunto->tipo == CONJUNTO_ORDENADO) || iter->de_enteros;
+	iter->pos = 0;
+	iter->indice = 0;
+	iter->actual = NULL;
+	iter->entero = 0;
+
+	hoja_ubicar(iter);
+
+	return iter;
+}
+
+/* Crean iteradores que recorren, sin calcularla antes, la unión, la
+   intersección, la diferencia o la diferencia simétrica de lo que
+   recorren iter1 e iter2, que pasan a pertenecerles. */
+conjunto_iter_t* conjunto_iter_union(conjunto_iter_t* iter1, conjunto_iter_t* iter2) {
+
+	return iter_combinar(ITER_UNION, iter1, iter2);
+}
+
+conjunto_iter_t* conjunto_iter_interseccion(conjunto_iter_t* iter1, conjunto_iter_t* iter2) {
+
+	return iter_combinar(ITER_INTERSECCION, iter1, iter2);
+}
+
+conjunto_iter_t* conjunto_iter_diferencia(conjunto_iter_t* iter1, conjunto_iter_t* iter2) {
+
+	return iter_combinar(ITER_DIFERENCIA, iter1, iter2);
+}
+
+conjunto_iter_t* conjunto_iter_diferencia_simetrica(conjunto_iter_t* iter1, conjunto_iter_t* iter2) {
+
+	return iter_combinar(ITER_DIFERENCIA_SIMETRICA, iter1, iter2);
+}
+
+/* Avanza el iterador. Devuelve false si quedó al final. */
+bool conjunto_iter_avanzar(conjunto_iter_t* iter) {
+
+	if (iter->al_final) return false;
+
+	iter_avanzar(iter);
+
+	return !iter->al_final;
+}
+
+/* Devuelve el dato actual, o NULL si está al final o recorre enteros. */
+void* conjunto_iter_ver_actual(const conjunto_iter_t* iter) {
+
+	if (iter->al_final || iter->de_enteros) return NULL;
+
+	return iter->actual;
+}
+
+/* Devuelve el entero actual de un iterador de enteros. */
+uint32_t conjunto_iter_ver_entero(const conjunto_iter_t* iter) {
+
+	return iter->entero;
+}
+
+/* Devuelve verdadero si el iterador está al final. */
+bool conjunto_iter_al_final(const conjunto_iter_t* iter) {
+
+	return iter->al_final;
+}
+
+/* Guarda en un conjunto nuevo los datos que le quedan por recorrer al
+   iterador, que queda al final. Devuelve NULL en caso de error. */
+conjunto_t* conjunto_iter_materializar(conjunto_iter_t* iter) {
+
+	conjunto_t modelo = { NULL, 0, 0, iter->cmp, NULL, CONJUNTO_ARREGLO, NULL, NULL, NULL, NULL, 0 };
+
+	if (iter->de_enteros) modelo.tipo = CONJUNTO_ENTEROS;
+	else if (iter->ordenado) modelo.tipo = CONJUNTO_ORDENADO;
+
+	conjunto_t* conjunto = conjunto_crear_como(&modelo, 0);
+
+	if (!conjunto) return NULL;
+
+	for (; !iter->al_final; iter_avanzar(iter)) {
+
+		if (!conjunto_anexar(conjunto, iter->actual, iter->entero)) {
+			conjunto_destruir(conjunto);
+			return NULL;
+		}
+	}
+
+	return conjunto;
+}
+
+/* Destruye el iterador y los que combina. */
+void conjunto_iter_destruir(conjunto_iter_t* iter) {
+
+	iter_destruir(iter);
+}
@@ -3,6 +3,7 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /* ******************************************************************
  *                DEFINICION DE LOS TIPOS DE DATOS
@@ -20,8 +21,15 @@ typedef int (*cmp_func_t) (const void *a, const void *b);
 
 typedef void (*destruir_dato_t) (void *);
 
+/* Prototipo de función de hash para los conjuntos creados con
+ * conjunto_crear_hash. Debe devolver el mismo valor para dos datos que la
+ * función de comparación considere iguales. */
+typedef uint64_t (*conjunto_hash_func_t) (const void *dato);
+
 typedef struct conjunto conjunto_t;
 
+typedef struct conjunto_iter conjunto_iter_t;
+
 /* ******************************************************************
  *                    PRIMITIVAS DEL CONJUNTO
  * *****************************************************************/
@@ -30,6 +38,40 @@ typedef struct conjunto conjunto_t;
    Devuelve un puntero a NULL en caso de error. */
 conjunto_t* conjunto_crear(int tamanio, cmp_func_t cmp, destruir_dato_t destruir_dato);
 
+/* Crea un conjunto de tamaño tam guardado en una tabla de hash: pertenecer,
+   agregar y eliminar cuestan O(1) en promedio, y la unión y la intersección
+   son lineales. El resto de las primitivas se usan igual.
+   Devuelve un puntero a NULL en caso de error. */
+conjunto_t* conjunto_crear_hash(int tamanio, cmp_func_t cmp, conjunto_hash_func_t fhash, destruir_dato_t destruir_dato);
+
+/* Crea un conjunto de tamaño tam que mantiene sus datos ordenados según
+   cmp: pertenecer cuesta O(log n), y la unión, la intersección y la
+   diferencia entre dos conjuntos ordenados con la misma cmp son lineales
+   (O(n + m)), o O(n log(m/n)) si uno es mucho más chico que el otro.
+   Agregar y eliminar cuestan O(n), porque desplazan los datos siguientes.
+   Devuelve un puntero a NULL en caso de error. */
+conjunto_t* conjunto_crear_ordenado(int tamanio, cmp_func_t cmp, destruir_dato_t destruir_dato);
+
+/* Crea un conjunto de enteros sin signo de 32 bits, con lugar para
+   tamanio enteros, que se guardan ordenados y se comparan sin cmp. Se usa
+   con las primitivas *_entero; conjunto_agregar, conjunto_eliminar y
+   conjunto_pertenece devuelven false con él. La unión, la intersección y
+   la diferencia entre dos conjuntos de enteros se hacen de a bloques con
+   SSE o AVX2 si se compila para un procesador que las tenga (por ejemplo,
+   con -march=native), y devuelven NULL si el otro no es del mismo tipo.
+   Devuelve un puntero a NULL en caso de error. */
+conjunto_t* conjunto_crear_enteros(int tamanio);
+
+/* Crea un conjunto de enteros sin signo de 32 bits guardado como mapa de
+   bits comprimido ("roaring bitmap"): los enteros se reparten según sus 16
+   bits altos en contenedores que guardan los 16 bits bajos en un arreglo
+   ordenado (hasta 4096), en un mapa de 8 KB o en tramos de enteros
+   consecutivos, lo que ocupe menos. Se usa con las primitivas *_entero,
+   igual que los creados con conjunto_crear_enteros, y la unión, la
+   intersección y la diferencia con otro mapa de bits operan de a palabras
+   de 64 bits. Devuelve un puntero a NULL en caso de error. */
+conjunto_t* conjunto_crear_bitmap(void);
+
 /* Agrega un dato al conjunto. Devuelve false en caso de error. */
 bool conjunto_agregar(conjunto_t* conjunto, void* dato);
 
@@ -40,15 +82,118 @@ bool conjunto_eliminar(conjunto_t* conjunto, void* dato);
    falso en caso contrario. */
 bool conjunto_pertenece(conjunto_t* conjunto, void* dato);
 
-/* Devuelve la unión de dos conjuntos en un conjunto nuevo.
-   Devueve NULL en caso de error. */
+/* Agrega un entero a un conjunto de enteros. Devuelve false si ya estaba
+   o en caso de error. */
+bool conjunto_agregar_entero(conjunto_t* conjunto, uint32_t entero);
+
+/* Elimina un entero de un conjunto de enteros. */
+bool conjunto_eliminar_entero(conjunto_t* conjunto, uint32_t entero);
+
+/* Devuelve verdadero si el entero pertenece al conjunto de enteros. */
+bool conjunto_pertenece_entero(conjunto_t* conjunto, uint32_t entero);
+
+/* Copia en 'destino', de menor a mayor, hasta tam enteros de un conjunto
+   de enteros. Devuelve cuántos copió. */
+size_t conjunto_copiar_enteros(conjunto_t* conjunto, uint32_t destino[], size_t tam);
+
+/* Devuelve la cantidad de datos del conjunto. */
+size_t conjunto_cantidad(conjunto_t* conjunto);
+
+/* Vuelve a guardar cada contenedor de un mapa de bits de la forma que
+   ocupe menos, incluidos los tramos de enteros consecutivos (agregar y
+   eliminar los pasan a arreglo o a mapa). Devuelve false en caso de error
+   o si el conjunto no es un mapa de bits. */
+bool conjunto_optimizar_bitmap(conjunto_t* conjunto);
+
+/* Devuelve los bytes que ocupa el conjunto, sin contar los datos a los que
+   apuntan sus punteros. */
+size_t conjunto_memoria(conjunto_t* conjunto);
+
+/* Devuelve la unión de dos conjuntos en un conjunto nuevo, que se guarda
+   igual que conjunto1. Devueve NULL en caso de error. */
 conjunto_t* conjunto_union(conjunto_t* conjunto1, conjunto_t* conjunto2);
 
-/* Devuelve la intersección de dos conjuntos en un conjunto nuevo.
-   Devueve NULL en caso de error. */
+/* Devuelve la intersección de dos conjuntos en un conjunto nuevo, que se
+   guarda igual que conjunto1. Devueve NULL en caso de error. */
 conjunto_t* conjunto_interseccion(conjunto_t* conjunto1, conjunto_t* conjunto2);
 
+/* Devuelve en un conjunto nuevo los datos de conjunto1 que no están en
+   conjunto2, guardado igual que conjunto1. Devueve NULL en caso de error. */
+conjunto_t* conjunto_diferencia(conjunto_t* conjunto1, conjunto_t* conjunto2);
+
+/* Igual que conjunto_union, pero si ambos conjuntos están ordenados con
+   la misma cmp, o son ambos creados con conjunto_crear_enteros, los corta
+   en hasta 'hilos' tramos de claves consecutivas con igual cantidad de
+   datos (merge path) y opera cada tramo en su propio hilo. Con otros
+   conjuntos, o si son chicos, opera sin hilos. Devueve NULL en caso de
+   error. */
+conjunto_t* conjunto_union_paralela(conjunto_t* conjunto1, conjunto_t* conjunto2, size_t hilos);
+
+/* Igual que conjunto_interseccion, repartida en hilos como
+   conjunto_union_paralela. Devueve NULL en caso de error. */
+conjunto_t* conjunto_interseccion_paralela(conjunto_t* conjunto1, conjunto_t* conjunto2, size_t hilos);
+
 /* Destruye el conjunto*/
 void conjunto_destruir (conjunto_t* conjunto);
 
+/* ******************************************************************
+ *                    PRIMITIVAS DEL ITERADOR
+ * *****************************************************************/
+
+/* Los iteradores recorren un conjunto o combinan otros iteradores sin
+ * crear conjuntos intermedios: (A ∩ B) ∪ (C − D) se recorre con
+ *
+ *   conjunto_iter_union(
+ *       conjunto_iter_interseccion(conjunto_iter_crear(A), conjunto_iter_crear(B)),
+ *       conjunto_iter_diferencia(conjunto_iter_crear(C), conjunto_iter_crear(D)))
+ *
+ * en una sola pasada, y cada paso avanza solo lo necesario (galopando
+ * sobre los conjuntos para saltear los datos que no pueden estar). Los
+ * conjuntos no se deben modificar mientras se recorren. */
+
+/* Crea un iterador que recorre el conjunto: de menor a mayor si es
+   ordenado o de enteros, o en cualquier orden si no.
+   Devuelve NULL en caso de error. */
+conjunto_iter_t* conjunto_iter_crear(conjunto_t* conjunto);
+
+/* Crean iteradores que recorren, de menor a mayor y sin calcularla antes,
+   la unión, la intersección, la diferencia (lo de iter1 que no está en
+   iter2) o la diferencia simétrica de lo que recorren iter1 e iter2, que
+   pasan a pertenecerles. Si un dato está en ambos, se toma el de iter1.
+   Ambos deben recorrer en orden datos comparables: conjuntos ordenados
+   con la misma cmp o conjuntos de enteros (de cualquier tipo).
+   Devuelven NULL, y destruyen iter1 e iter2, si alguno es NULL, si no se
+   pueden combinar o en caso de error; así las llamadas se pueden anidar. */
+conjunto_iter_t* conjunto_iter_union(conjunto_iter_t* iter1, conjunto_iter_t* iter2);
+
+conjunto_iter_t* conjunto_iter_interseccion(conjunto_iter_t* iter1, conjunto_iter_t* iter2);
+
+conjunto_iter_t* conjunto_iter_diferencia(conjunto_iter_t* iter1, conjunto_iter_t* iter2);
+
+conjunto_iter_t* conjunto_iter_diferencia_simetrica(conjunto_iter_t* iter1, conjunto_iter_t* iter2);
+
+/* Avanza al dato siguiente. Devuelve false si quedó al final. */
+bool conjunto_iter_avanzar(conjunto_iter_t* iter);
+
+/* Devuelve el dato actual, o NULL si el iterador está al final o recorre
+   enteros. */
+void* conjunto_iter_ver_actual(const conjunto_iter_t* iter);
+
+/* Devuelve el entero actual de un iterador de enteros.
+   Pre: el iterador no está al final. */
+uint32_t conjunto_iter_ver_entero(const conjunto_iter_t* iter);
+
+/* Devuelve verdadero si el iterador está al final. */
+bool conjunto_iter_al_final(const conjunto_iter_t* iter);
+
+/* Guarda en un conjunto nuevo los datos que le quedan por recorrer al
+   iterador, que queda al final: de enteros si los recorre, ordenado con
+   la misma cmp si recorre en orden, o común si no. El conjunto nuevo no
+   destruye sus datos, que siguen siendo de los conjuntos recorridos.
+   Devuelve NULL en caso de error. */
+conjunto_t* conjunto_iter_materializar(conjunto_iter_t* iter);
+
+/* Destruye el iterador y los iteradores que combina. */
+void conjunto_iter_destruir(conjunto_iter_t* iter);
+
 #endif // CONJUNTO_T
\ No newline at end of file
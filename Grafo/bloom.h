@@ -0,0 +1,66 @@
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+// Filtro de Bloom: conjunto aproximado de claves que ocupa unos pocos
+// bits por clave. Si responde que una clave no está, seguro que no se
+// agregó; si responde que puede estar, se equivoca con una probabilidad
+// que depende de los bits por clave (alrededor de 1% con 10 bits).
+// Las claves no se pueden quitar.
+typedef struct bloom bloom_t;
+
+/* ******************************************************************
+ *                    PRIMITIVAS DEL FILTRO
+ * *****************************************************************/
+
+// Crea un filtro para 'capacidad' claves, con bits_por_clave bits por
+// clave y k funciones de hash. Si k es 0 se usa la cantidad que minimiza
+// los falsos positivos (bits_por_clave * ln 2).
+// Post: devuelve un filtro vacío, o NULL en caso de error.
+bloom_t* bloom_crear(size_t capacidad, size_t bits_por_clave, size_t k);
+
+// Igual que bloom_crear, pero los k bits de cada clave caen en un mismo
+// bloque de 64 bytes: cada operación lee o escribe una sola línea de
+// memoria. A cambio, hay algunos falsos positivos más con los mismos bits.
+// Post: devuelve un filtro vacío, o NULL en caso de error.
+bloom_t* bloom_crear_bloques(size_t capacidad, size_t bits_por_clave, size_t k);
+
+// Agrega una clave al filtro.
+// Pre: el filtro fue creado.
+void bloom_agregar(bloom_t *bloom, const char *clave);
+
+// Verifica si la clave puede estar en el filtro.
+// Pre: el filtro fue creado.
+// Post: devuelve false sólo si la clave seguro no se agregó.
+bool bloom_puede_contener(const bloom_t *bloom, const char *clave);
+
+// Equivalentes a las dos anteriores para quien ya tiene calculado un hash
+// de 64 bits de la clave, que debe ser siempre el mismo para la misma clave.
+void bloom_agregar_hash(bloom_t *bloom, uint64_t hash);
+
+bool bloom_puede_contener_hash(const bloom_t *bloom, uint64_t hash);
+
+// Devuelve la cantidad de claves agregadas (contando las repetidas).
+// Pre: el filtro fue creado.
+size_t bloom_cantidad(const bloom_t *bloom);
+
+// Devuelve la cantidad de claves para la que se creó el filtro.
+// Pre: el filtro fue creado.
+size_t bloom_capacidad(const bloom_t *bloom);
+
+// Vacía el filtro.
+// Pre: el filtro fue creado.
+void bloom_limpiar(bloom_t *bloom);
+
+// Destruye el filtro.
+// Pre: el filtro fue creado.
+void bloom_destruir(bloom_t *bloom);
+
+#endif // BLOOM_H
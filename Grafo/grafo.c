@@ -4,6 +4,11 @@
 #include "lista.h"
 #include "hash.h"
 
+// Bits por clave del filtro de Bloom de los adyacentes de cada vertice: con
+// 10, alrededor del 1% de las consultas por un vertice que no es adyacente
+// llegan a recorrer la tabla.
+#define BITS_FILTRO_ADYACENTES 10
+
 /* ******************************************************************
  *                DEFINICION DE LOS TIPOS DE DATOS
  * *****************************************************************/
@@ -46,9 +51,51 @@ static vertice_t* crear_vertice(const char* clave, void* dato) {
 	vertice->adyacentes = hash_crear_default(NULL);
 	vertice->cant_adyacentes = 0;
 
+	// La mayoría de las consultas de grafo_adyacente_pertence son por
+	// vertices que no son adyacentes: el filtro las descarta sin recorrer la
+	// tabla. Si no hay memoria para el filtro, la tabla funciona igual.
+	if (vertice->adyacentes) hash_agregar_filtro(vertice->adyacentes, BITS_FILTRO_ADYACENTES);
+
 	return vertice;
 }
 
+// Libera un vertice, destruyendo su dato si se recibe la funcion para hacerlo.
+static void destruir_vertice(vertice_t* vertice, grafo_destruir_dato_t destruir_dato) {
+
+	if (destruir_dato) destruir_dato(vertice->dato);
+
+	free(vertice->clave);
+	hash_destruir(vertice->adyacentes);
+	free(vertice);
+}
+
+typedef struct borrado_vertice {
+	grafo_t* grafo;
+	const char* vertice;
+} borrado_vertice_t;
+
+// Visitante de hash_iterar que quita el vertice borrado de la lista de
+// adyacentes de cada uno de sus vecinos.
+static bool quitar_de_adyacente(const char* clave, void* dato, void* extra) {
+
+	borrado_vertice_t* borrado = extra;
+	vertice_t* adyacente = hash_obtener(borrado->grafo->vertices, clave);
+
+	if (adyacente) hash_borrar(adyacente->adyacentes, borrado->vertice);
+
+	return true;
+}
+
+// Visitante de hash_iterar que destruye cada vertice del grafo.
+static bool destruir_vertice_visitar(const char* clave, void* dato, void* extra) {
+
+	grafo_t* grafo = extra;
+
+	destruir_vertice(dato, grafo->destruir_dato);
+
+	return true;
+}
+
 /* ******************************************************************
  *                      PRIMITIVAS DEL GRAFO
  * *****************************************************************/
@@ -126,23 +173,11 @@ void* grafo_borrar_vertice(grafo_t* grafo, char* vertice) {
 	vertice_t* vertice_aux = hash_borrar_dato(grafo->vertices, vertice);
 	void* valor = vertice_aux->dato;
 
-	lista_t* lista_claves = hash_claves(vertice_aux->adyacentes);
-	lista_iter_t* iter = lista_iter_crear(lista_claves);
-	
-	while (!lista_iter_al_final(iter)) {
-		
-		vertice_t* vertice_aux2 = hash_obtener(grafo->vertices, lista_iter_ver_actual(iter));
-		hash_borrar(vertice_aux2->adyacentes, vertice);
-		lista_iter_avanzar(iter);
-	}
-
-	lista_iter_destruir(iter);
-	lista_destruir(lista_claves, NULL);
+	borrado_vertice_t borrado = { grafo, vertice };
+	hash_iterar(vertice_aux->adyacentes, quitar_de_adyacente, &borrado);
 
 	grafo->cantidad_aristas = grafo->cantidad_aristas - vertice_aux->cant_adyacentes;
-	free(vertice_aux->clave);
-	hash_destruir(vertice_aux->adyacentes);
-	free(vertice_aux);
+	destruir_vertice(vertice_aux, NULL);
 
 	(grafo->cantidad_vertices)--;
 	
@@ -205,30 +240,7 @@ lista_t* grafo_vertices(const grafo_t* grafo) {
 
 void grafo_destruir(grafo_t* grafo) {
 
-	if (!grafo_esta_vacio(grafo)) {
-
-		lista_t* lista_claves = hash_claves(grafo->vertices);
-		lista_iter_t* iter = lista_iter_crear(lista_claves);
-		grafo_destruir_dato_t destruir_dato = grafo->destruir_dato;
-
-		while (!lista_iter_al_final(iter)) {
-
-			vertice_t* vertice_aux = hash_borrar_dato(grafo->vertices, lista_iter_ver_actual(iter));
-			free(vertice_aux->clave);
-			
-			if (destruir_dato) {
-				destruir_dato(vertice_aux->dato);
-			}
-			
-			hash_destruir(vertice_aux->adyacentes);
-			free(vertice_aux);
-			lista_iter_avanzar(iter);
-		}
-
-		lista_iter_destruir(iter);
-		lista_destruir(lista_claves, NULL);
-	}
-	
+	hash_iterar(grafo->vertices, destruir_vertice_visitar, grafo);
 	hash_destruir(grafo->vertices);
 	free(grafo);
 }
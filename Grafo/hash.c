@@ -1,12 +1,103 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
 #include "lista.h"
+#include "bloom.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
-#define TAM_INICIAL 101
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+
+// Los tamaños son potencias de dos: la posición se obtiene enmascarando el hash.
+#define TAM_INICIAL 128
 #define MAX_FACTOR_DE_CARGA 1.5
 #define MIN_FACTOR_DE_CARGA 0.25
-#define FACTOR_MULTIPLICACION 3
+#define FACTOR_MULTIPLICACION 2
+
+// Cantidad de baldes de la tabla vieja que se mudan en cada guardado o borrado
+// mientras hay una redimensión en curso.
+#define BALDES_POR_PASO 8
+
+// Tabla abierta: los bytes de control se recorren en grupos de TAM_GRUPO.
+#define TAM_GRUPO 16
+#define TAM_INICIAL_ABIERTO 16
+#define CONTROL_VACIO 0x80
+#define CONTROL_BORRADO 0xFE
+#define NO_ENCONTRADO SIZE_MAX
+
+// Cada ranura de la tabla abierta ocupa una línea de memoria y guarda el
+// nodo con su clave, si la clave tiene menos de LARGO_CLAVE_CORTA bytes.
+#define TAM_RANURA 64
+#define LARGO_CLAVE_CORTA (TAM_RANURA - sizeof(clave_valor_t))
+
+// Tabla ordenada: el índice (potencia de dos) tiene tres ranuras por cada
+// dos entradas del arreglo denso.
+#define TAM_INICIAL_ORDENADO 8
+#define INDICE_VACIO SIZE_MAX
+#define INDICE_BORRADO (SIZE_MAX - 1)
+
+// Cantidad de claves que las operaciones por lote resuelven a la vez:
+// primero se calculan sus hashes y se precargan sus baldes, y recién
+// después se recorren, así las esperas a memoria se superponen.
+#define TAM_LOTE 16
+
+// hash_construir no reparte en más hilos que uno cada MIN_PARES_POR_HILO pares.
+#define MIN_PARES_POR_HILO 4096
+
+// El filtro se reconstruye con lugar para el doble de las claves que hay,
+// y nunca para menos de CAPACIDAD_MINIMA_FILTRO.
+#define CAPACIDAD_MINIMA_FILTRO 64
+
+// El LRU muestreado desaloja la clave usada hace más tiempo entre
+// MUESTRAS_DESALOJO elegidas al azar.
+#define MUESTRAS_DESALOJO 5
+#define SEMILLA_DESALOJO 0x9e3779b97f4a7c15ULL
+
+// Imagen binaria de la tabla (ver hash_serializar).
+#define FIRMA_IMAGEN "TDAHASH1"
+#define TAM_INICIAL_IMAGEN 16
+#define TAM_BUFER_ESCRITURA 65536
+
+// Constantes de wyhash.
+#define WY_P0 0xa0761d6478bd642fULL
+#define WY_P1 0xe7037ed1a0b428dbULL
+
+#define FNV_BASE 0xcbf29ce484222325ULL
+#define FNV_PRIMO 0x100000001b3ULL
+
+// Polinomio de CRC32C (Castagnoli), en su forma reflejada.
+#define CRC32C_POLINOMIO 0x82f63b78U
+
+// Con HASH_ESTADISTICAS definido se cuentan las búsquedas y las
+// comparaciones de claves que reporta hash_estadisticas. Las búsquedas
+// reciben la tabla como constante, pero la tabla siempre se reserva con
+// malloc, así que puede modificarse quitándole el const.
+#ifdef HASH_ESTADISTICAS
+#define CONTAR(hash, campo) ((((hash_t*) (hash))->campo)++)
+#else
+#define CONTAR(hash, campo) ((void) 0)
+#endif
+
+#define HASH_LARGO_HISTOGRAMA 16
+
+#ifdef __GNUC__
+#define PRECARGAR(direccion) __builtin_prefetch(direccion)
+#else
+#define PRECARGAR(direccion) ((void) (direccion))
+#endif
 
 /* ******************************************************************
  *                DEFINICION DE LOS TIPOS DE DATOS
@@ -14,24 +105,182 @@
 
 typedef void (*hash_destruir_dato_t) (void *);
 
-typedef size_t (*f_hash_t) (const char* clave, size_t tam);
+typedef uint64_t (*f_hash_t) (const char* clave, size_t largo);
+
+typedef const void* (*hash_serializar_dato_t) (const void* dato, size_t* largo);
+
+typedef size_t (*hash_tamanio_dato_t) (const void* dato);
+
+typedef enum hash_politica {
+	HASH_DESALOJO_RELOJ,
+	HASH_DESALOJO_LRU_MUESTREADO,
+	HASH_DESALOJO_ALEATORIO
+} hash_politica_t;
+
+typedef enum hash_tipo {
+	HASH_ENCADENADO,
+	HASH_ABIERTO,
+	HASH_MAPEADO,
+	HASH_ORDENADO
+} hash_tipo_t;
+
+typedef struct hash_estadisticas {
+	hash_tipo_t tipo;
+	size_t cantidad;
+	size_t baldes;
+	size_t baldes_ocupados;
+	size_t histograma[HASH_LARGO_HISTOGRAMA];
+	size_t largo_maximo;
+	double largo_promedio;
+	size_t redimensiones;
+	size_t bytes;
+	size_t busquedas;
+	double sondeos_por_busqueda;
+	double comparaciones_por_busqueda;
+	size_t desalojos;
+} hash_estadisticas_t;
+
+// La clave se guarda al final del nodo, en la misma reserva de memoria.
+// 'uso' es la marca que deja la última búsqueda de la clave, y sólo se
+// usa para elegir qué desalojar en las tablas con presupuesto.
+typedef struct clave_valor {
+	uint64_t hash;
+	uint32_t largo;
+	uint32_t uso;
+	struct clave_valor *siguiente;
+	void *valor;
+	char clave[];
+} clave_valor_t;
 
 typedef struct hash {
-	void* *datos;
+	clave_valor_t* *datos;
 	size_t cantidad_elementos;
 	size_t tamanio;
 	hash_destruir_dato_t destruir_dato;
 	f_hash_t fhash;
+	clave_valor_t* *datos_viejos;
+	size_t tamanio_viejo;
+	size_t migrados;
+	float factor_min;
+	float factor_max;
+	size_t tamanio_minimo;
+	hash_tipo_t tipo;
+	uint8_t *control;
+	char *ranuras;
+	size_t borrados;
+	const uint8_t *imagen;
+	size_t largo_imagen;
+	clave_valor_t* *entradas;
+	size_t *indice;
+	size_t usadas;
+	bloom_t *filtro;
+	size_t bits_filtro;
+	size_t redimensiones;
+	size_t presupuesto;
+	size_t memoria;
+	hash_tamanio_dato_t tamanio_dato;
+	hash_politica_t politica;
+	uint32_t marca;
+	size_t aguja;
+	uint64_t azar;
+	size_t desalojos;
+#ifdef HASH_ESTADISTICAS
+	size_t busquedas;
+	size_t sondeos;
+	size_t comparaciones;
+#endif
 } hash_t;
 
-typedef struct clave_valor {
-	char *clave;
-	void *valor;
-} clave_valor_t;
+/* La imagen de una tabla es un encabezado, seguido de un índice de
+ * 'tamanio' ranuras (direccionamiento abierto con sondeo lineal) y de las
+ * entradas. Cada ranura ocupada guarda el hash de la clave y el
+ * desplazamiento de su entrada desde el principio del archivo; las libres
+ * tienen desplazamiento 0. Todo está alineado a 8 bytes y no hay punteros,
+ * así que la imagen se puede usar en cualquier dirección en la que se mapee. */
+typedef struct imagen_encabezado {
+	char firma[8];
+	uint64_t cantidad;
+	uint64_t tamanio;
+	uint64_t largo;
+} imagen_encabezado_t;
+
+typedef struct imagen_ranura {
+	uint64_t hash;
+	uint64_t desplazamiento;
+} imagen_ranura_t;
+
+// A la clave (con su '\0') le sigue el valor, en el siguiente múltiplo de 8.
+typedef struct imagen_entrada {
+	uint64_t largo_clave;
+	uint64_t largo_valor;
+	char clave[];
+} imagen_entrada_t;
+
+typedef struct elemento_serializado {
+	const char* clave;
+	size_t largo_clave;
+	const void* valor;
+	size_t largo_valor;
+} elemento_serializado_t;
+
+typedef bool (*visitar_entrada_t) (const char* clave, size_t largo, void* dato, void* extra);
+
+typedef struct visitante {
+	bool (*visitar) (const char* clave, void* dato, void* extra);
+	void* extra;
+} visitante_t;
+
+typedef struct serializacion {
+	elemento_serializado_t* elementos;
+	size_t cantidad;
+	hash_serializar_dato_t serializar_dato;
+} serializacion_t;
+
+typedef struct escritor {
+	int fd;
+	char bufer[TAM_BUFER_ESCRITURA];
+	size_t usados;
+} escritor_t;
+
+typedef struct hash_par {
+	const char* clave;
+	void* dato;
+} hash_par_t;
+
+/* hash_construir trabaja en tres etapas, cada una repartida entre los
+ * hilos. Cada hilo crea los nodos de una porción de los pares y cuenta
+ * cuántos caen en cada partición (un rango contiguo de baldes); después
+ * los copia agrupados por partición, y por último cada hilo engancha los
+ * nodos de una partición en sus baldes, que no comparte con nadie. */
+typedef struct construccion {
+	const hash_par_t* pares;
+	size_t n;
+	size_t hilos;
+	hash_t* hash;
+	clave_valor_t* *nodos;
+	clave_valor_t* *agrupados;
+	size_t *desplazamientos;
+	size_t *inicio_particion;
+} construccion_t;
+
+typedef struct trabajo {
+	construccion_t* construccion;
+	size_t numero;
+	pthread_t hilo;
+	bool creado;
+	bool exito;
+	size_t guardados;
+} trabajo_t;
+
+typedef struct arreglo_claves {
+	const char* *claves;
+	size_t tam;
+	size_t cantidad;
+} arreglo_claves_t;
 
 typedef struct hash_iter {
 	size_t posicion_actual;
-	lista_iter_t *lista_iter;
+	clave_valor_t *actual;
 	const hash_t* hash;
 	bool al_final;
 } hash_iter_t;
@@ -41,35 +290,65 @@ typedef struct hash_iter {
  * *****************************************************************/
 
 //"Rotating Hash" tomada desde http://burtleburtle.net/bob/hash/doobs.html
-static size_t fhash(const char*clave, size_t tam){
+// Es la que usan las imágenes (ver hash_serializar): cambiarla obliga a
+// cambiar FIRMA_IMAGEN.
+static uint64_t fhash(const char*clave, size_t largo){
 
-	long int hash = 0;
-    long int i = 0;
+	uint64_t hash = 0;
 
-	while (clave[i] != '\0'){
+	for (size_t i = 0; i < largo; i++)
+		hash = ((hash<<4)^(hash>>28)^clave[i]);
 
-        hash = ((hash<<4)^(hash>>28)^clave[i]);
-		i++;
-    }
-    return hash%tam;
+	return hash;
 }
 
-// Crea un nuevo nodo con la clave y su correspondiente valor asociado.
-static clave_valor_t* hash_crear_nodo(const char* clave, void* dato) {
+// Mezcla los bits del valor de hash para que tanto los bits bajos (que
+// eligen el balde o el grupo) como los altos varíen con toda la clave.
+static uint64_t mezclar(uint64_t h) {
 
-	clave_valor_t* nodo = malloc(sizeof(clave_valor_t));
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
 
-	if (!nodo) return NULL;
+	return h;
+}
 
-	nodo->clave = malloc(sizeof(char)*(strlen(clave)+1));
+// Calcula el hash completo de una clave. Es el valor que se guarda en el
+// nodo, así las comparaciones y las redimensiones no vuelven a calcularlo.
+static uint64_t hash_calcular(const hash_t* hash, const char* clave, size_t largo) {
 
-	if (!nodo->clave) {
-		free(nodo);
-		return NULL;
-	}
+	return mezclar(hash->fhash(clave, largo));
+}
+
+// Verifica si el nodo guarda la clave buscada. Compara primero el hash y el
+// largo para evitar la comparación de cadenas en casi todos los descartes.
+static bool nodo_es_clave(const hash_t* hash, const clave_valor_t* nodo, const char* clave, size_t largo, uint64_t h) {
+
+	CONTAR(hash, sondeos);
+
+	if (nodo->hash != h || nodo->largo != largo) return false;
+
+	CONTAR(hash, comparaciones);
+
+	return (memcmp(nodo->clave, clave, largo) == 0);
+}
+
+// Crea un nuevo nodo con la clave y su correspondiente valor asociado.
+static clave_valor_t* hash_crear_nodo(const hash_t* hash, const char* clave, size_t largo, uint64_t h, void* dato) {
+
+	clave_valor_t* nodo = malloc(sizeof(clave_valor_t) + sizeof(char)*(largo+1));
+
+	if (!nodo) return NULL;
 
-	strcpy(nodo->clave, clave);
+	memcpy(nodo->clave, clave, largo);
+	nodo->clave[largo] = '\0';
 	nodo->valor = dato;
+	nodo->hash = h;
+	nodo->largo = (uint32_t) largo;
+	nodo->uso = hash->marca;
+	nodo->siguiente = NULL;
 
 	return nodo;
 }
@@ -78,7 +357,6 @@ static clave_valor_t* hash_crear_nodo(const char* clave, void* dato) {
 static void* hash_destuir_nodo(clave_valor_t* nodo) {
 
 	void* dato = nodo->valor;
-	free(nodo->clave);
 	free(nodo);
 
 	return dato;
@@ -90,35 +368,68 @@ static bool hash_esta_vacio(const hash_t* hash) {
 	return (hash->cantidad_elementos == 0);
 }
 
-// Busca una clave en el Hash.
-static bool hash_buscar(const hash_t* hash, const char* clave, lista_iter_t* iter) {
+// Pone en cero los contadores que reporta hash_estadisticas.
+static void hash_inicializar_contadores(hash_t* hash) {
 
-	size_t pos = hash->fhash(clave,hash->tamanio);
+	hash->redimensiones = 0;
+	hash->desalojos = 0;
+#ifdef HASH_ESTADISTICAS
+	hash->busquedas = 0;
+	hash->sondeos = 0;
+	hash->comparaciones = 0;
+#endif
+}
+
+// Busca una clave en una cadena del Hash. Devuelve el lugar que apunta al
+// nodo encontrado, o al final de la cadena si la clave no está, para poder
+// enganchar o desenganchar el nodo sin recorrerla de nuevo.
+static clave_valor_t* *hash_buscar(const hash_t* hash, clave_valor_t* *balde, const char* clave, size_t largo, uint64_t h) {
 
-	if (hash_esta_vacio(hash) || lista_esta_vacia(hash->datos[pos])) return false;
+	CONTAR(hash, busquedas);
 
-	clave_valor_t *clave_valor_aux;
-	char *clave_aux;
+	while (*balde && !nodo_es_clave(hash, *balde, clave, largo, h))
+		balde = &(*balde)->siguiente;
+
+	return balde;
+}
 
-	while (!lista_iter_al_final(iter)) {
+// Devuelve el lugar del balde que le corresponde a la clave. Mientras dura
+// una redimensión, las claves cuyo balde viejo todavía no se mudó siguen
+// estando en la tabla vieja.
+static clave_valor_t* *hash_balde(const hash_t* hash, uint64_t h) {
 
-		clave_valor_aux = lista_iter_ver_actual(iter);
-		clave_aux = clave_valor_aux->clave;
+	if (hash->datos_viejos) {
 
-		if (strcmp(clave_aux,clave) == 0) return true;
+		size_t posicion_vieja = h & (hash->tamanio_viejo - 1);
 
-		lista_iter_avanzar(iter);
+		if (posicion_vieja >= hash->migrados)
+			return &hash->datos_viejos[posicion_vieja];
 	}
 
-	return false;
+	return &hash->datos[h & (hash->tamanio - 1)];
 }
 
-// Devuelve la posición en el hash donde está el próxima lista guardada.
+// Devuelve el balde en la posición i, contando primero los de la tabla
+// vieja (si hay una redimensión en curso) y después los de la nueva.
+static clave_valor_t* hash_balde_en(const hash_t* hash, size_t i) {
+
+	if (i < hash->tamanio_viejo) return hash->datos_viejos[i];
+
+	return hash->datos[i - hash->tamanio_viejo];
+}
+
+// Devuelve la cantidad total de baldes, sumando ambas tablas.
+static size_t hash_cantidad_baldes(const hash_t* hash) {
+
+	return hash->tamanio_viejo + hash->tamanio;
+}
+
+// Devuelve la posición en el hash donde está el próxima cadena guardada.
 static size_t hash_proximo_elemento(const hash_t* hash,size_t posicion_inicial) {
 
 	size_t i = posicion_inicial + 1;
 
-	while((i < hash->tamanio) && lista_esta_vacia(hash->datos[i]))
+	while((i < hash_cantidad_baldes(hash)) && !hash_balde_en(hash, i))
 		i++;
 
 	return i;
@@ -130,292 +441,2545 @@ static bool factor_hash_superado(hash_t* hash) {
 	float cantidad_elementos = hash->cantidad_elementos;
 	float tamanio = hash->tamanio;
 
-	return (cantidad_elementos/tamanio) >= MAX_FACTOR_DE_CARGA;
+	return (cantidad_elementos/tamanio) >= hash->factor_max;
+}
+
+// Devuelve true si la tabla quedó por debajo del factor de carga mínimo y
+// todavía puede achicarse. La distancia entre ambos factores evita que una
+// tabla cerca del límite crezca y se achique en operaciones alternadas.
+// La abierta no usa factor_max: crece al llenar 7/8 de sus ranuras, así que
+// se achica recién por debajo de 7/8 / (2 * FACTOR_MULTIPLICACION) aunque
+// factor_min sea mayor; si no, al crecer ya quedaría para achicarse.
+static bool factor_hash_insuficiente(hash_t* hash) {
+
+	float cantidad_elementos = hash->cantidad_elementos;
+	float tamanio = hash->tamanio;
+	float factor_min = hash->factor_min;
+
+	if (hash->tipo == HASH_ABIERTO && factor_min * 8 * 2 * FACTOR_MULTIPLICACION > 7)
+		factor_min = 7.0f / (8 * 2 * FACTOR_MULTIPLICACION);
+
+	return (hash->tamanio > hash->tamanio_minimo) && (cantidad_elementos/tamanio) < factor_min;
 }
 
-// Redimensiona el Hash cuando el factor de carga se supera.
-static bool hash_redimensionar(hash_t* hash) {
+// Devuelve el menor tamaño de la tabla encadenada en el que entran
+// 'cantidad' elementos sin superar el factor de carga.
+static size_t encadenado_tamanio_para(const hash_t* hash, size_t cantidad) {
 
-	int nuevo_tamanio = hash->tamanio * FACTOR_MULTIPLICACION;
+	size_t tamanio = TAM_INICIAL;
 
-	void* *datos_viejos = hash->datos;
-	hash->datos = malloc(sizeof(void*)*nuevo_tamanio);
+	while ((float) cantidad >= (float) tamanio * hash->factor_max)
+		tamanio *= FACTOR_MULTIPLICACION;
 
-	if(!hash->datos) return false;
+	return tamanio;
+}
 
-	for (int i = 0; i < nuevo_tamanio; i++) {
-		hash->datos[i] = lista_crear();
-	}
+// Muda a la tabla nueva hasta 'baldes' baldes de la tabla vieja.
+// Cuando se mudó el último, libera la tabla vieja.
+static void hash_migrar(hash_t* hash, size_t baldes) {
 
-	int posicion_nueva;
-	clave_valor_t* aux_nodo;
+	while (hash->datos_viejos && baldes > 0) {
 
-	for (int i = 0; i < hash->tamanio; i++) {
+		clave_valor_t* nodo = hash->datos_viejos[hash->migrados];
 
-		while (!lista_esta_vacia(datos_viejos[i])) {
+		while (nodo) {
 
-			aux_nodo = lista_borrar_primero(datos_viejos[i]);
-			posicion_nueva = hash->fhash(aux_nodo->clave,nuevo_tamanio);
-			lista_insertar_primero(hash->datos[posicion_nueva],aux_nodo);
+			clave_valor_t* siguiente = nodo->siguiente;
+			clave_valor_t* *destino = &hash->datos[nodo->hash & (hash->tamanio - 1)];
+
+			nodo->siguiente = *destino;
+			*destino = nodo;
+			nodo = siguiente;
 		}
 
-		lista_destruir(datos_viejos[i], NULL);
+		hash->datos_viejos[hash->migrados] = NULL;
+		(hash->migrados)++;
+		baldes--;
+
+		if (hash->migrados == hash->tamanio_viejo) {
+
+			free(hash->datos_viejos);
+			hash->datos_viejos = NULL;
+			hash->tamanio_viejo = 0;
+			hash->migrados = 0;
+		}
 	}
+}
+
+// Redimensiona el Hash al nuevo tamaño. Sólo reserva la tabla nueva: los
+// elementos se mudan de a poco en cada guardado o borrado, para que
+// ninguna operación cargue con el costo de mover toda la tabla.
+static bool hash_redimensionar(hash_t* hash, size_t nuevo_tamanio) {
+
+	// La mudanza anterior termina mucho antes de volver a superar el factor
+	// de carga; si no, se completa ahora.
+	hash_migrar(hash, hash->tamanio_viejo);
+
+	clave_valor_t* *datos_nuevos = calloc(nuevo_tamanio, sizeof(clave_valor_t*));
 
-	free(datos_viejos);
+	if (!datos_nuevos) return false;
+
+	hash->datos_viejos = hash->datos;
+	hash->tamanio_viejo = hash->tamanio;
+	hash->migrados = 0;
+	hash->datos = datos_nuevos;
 	hash->tamanio = nuevo_tamanio;
-	
+	(hash->redimensiones)++;
+
 	return true;
 }
 
 /* ******************************************************************
- *                    PRIMITIVAS DEL HASH
- * ******************************************************************/
+ *                    FUNCIONES AUXILIARES DE HASH
+ * *****************************************************************/
 
-hash_t* hash_crear(hash_destruir_dato_t destruir_dato, f_hash_t fhash) {
+// Leen 8 y 4 bytes de una dirección sin alinear.
+static uint64_t leer64(const char* p) {
 
-	hash_t* hash = malloc(sizeof(hash_t));
-	if (!hash) return NULL;
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
 
+	return v;
+}
 
-	hash->datos = malloc(sizeof(void*)*TAM_INICIAL);
+static uint64_t leer32(const char* p) {
 
-	if (!hash->datos) {
-		free(hash);
-		return NULL;
-	}
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+
+	return v;
+}
+
+// Multiplica a y b en 128 bits y combina ambas mitades del producto.
+static uint64_t wy_mezclar(uint64_t a, uint64_t b) {
+
+#ifdef __SIZEOF_INT128__
+	__uint128_t producto = (__uint128_t) a * b;
+
+	return (uint64_t) producto ^ (uint64_t) (producto >> 64);
+#else
+	uint64_t a_alto = a >> 32, a_bajo = (uint32_t) a;
+	uint64_t b_alto = b >> 32, b_bajo = (uint32_t) b;
+	uint64_t medio_1 = a_alto * b_bajo, medio_2 = a_bajo * b_alto;
+	uint64_t bajo = a_bajo * b_bajo;
+	uint64_t alto = a_alto * b_alto;
+	uint64_t acarreo = ((bajo >> 32) + (uint32_t) medio_1 + (uint32_t) medio_2) >> 32;
+
+	bajo += (medio_1 << 32) + (medio_2 << 32);
+	alto += (medio_1 >> 32) + (medio_2 >> 32) + acarreo;
+
+	return bajo ^ alto;
+#endif
+}
+
+#ifndef __SSE4_2__
+static uint32_t crc32c_tabla[256];
+static pthread_once_t crc32c_inicializada = PTHREAD_ONCE_INIT;
+
+static void crc32c_inicializar(void) {
+
+	for (uint32_t i = 0; i < 256; i++) {
 
-	for (int i = 0; i < TAM_INICIAL; i++) {
-		hash->datos[i] = lista_crear();
+		uint32_t crc = i;
+
+		for (int bit = 0; bit < 8; bit++)
+			crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLINOMIO : 0);
+
+		crc32c_tabla[i] = crc;
 	}
+}
+#endif
+
+// Avanzan el CRC32C con un byte y con 8 bytes (en el orden de la memoria).
+// Con SSE4.2 usan la instrucción crc32; si no, una tabla por byte que da
+// los mismos resultados.
+static uint32_t crc32c_byte(uint32_t crc, unsigned char byte) {
+
+#ifdef __SSE4_2__
+	return _mm_crc32_u8(crc, byte);
+#else
+	return (crc >> 8) ^ crc32c_tabla[(crc ^ byte) & 0xff];
+#endif
+}
 
-	hash->cantidad_elementos = 0;
-	hash->tamanio = TAM_INICIAL;
-	hash->destruir_dato = destruir_dato;
-	hash->fhash = fhash;
+static uint32_t crc32c_palabra(uint32_t crc, const char* p) {
 
-	return hash;
+#ifdef __SSE4_2__
+	return (uint32_t) _mm_crc32_u64(crc, leer64(p));
+#else
+	for (size_t i = 0; i < sizeof(uint64_t); i++)
+		crc = crc32c_byte(crc, (unsigned char) p[i]);
+
+	return crc;
+#endif
 }
 
-hash_t* hash_crear_default(hash_destruir_dato_t destruir_dato) {
+/* ******************************************************************
+ *                 FUNCIONES AUXILIARES DE LA TABLA ABIERTA
+ * *****************************************************************/
 
-	return hash_crear(destruir_dato, fhash);
+/* Las ranuras guardan los nodos en la tabla misma, así una búsqueda que
+ * acierta lee el byte de control y una sola línea de memoria, y guardar una
+ * clave corta no pide memoria. Una ranura ocupada empieza con un
+ * clave_valor_t: si la clave es corta, es el nodo, con la clave a
+ * continuación dentro de la ranura; si no, sólo valen su hash y su largo, y
+ * 'siguiente' apunta al nodo, que se reserva aparte como en la encadenada.
+ * Como nada apunta a las ranuras, se mudan copiándolas. */
+
+// Indica si una clave de ese largo se guarda dentro de la ranura.
+static bool abierto_clave_corta(size_t largo) {
+
+	return largo < LARGO_CLAVE_CORTA;
 }
 
-bool hash_guardar(hash_t *hash, const char *clave, void *dato) {
+// Devuelve el comienzo de la ranura pos.
+static clave_valor_t* abierto_ranura(const hash_t* hash, size_t pos) {
 
-	if (factor_hash_superado(hash)) {
+	return (clave_valor_t*) (hash->ranuras + pos * TAM_RANURA);
+}
 
-		if (!hash_redimensionar(hash)) return false;
-	}
+// Devuelve el nodo guardado en la ranura ocupada pos.
+static clave_valor_t* abierto_nodo(const hash_t* hash, size_t pos) {
 
-	bool salida = true;
-	size_t posicion = hash->fhash(clave, hash->tamanio);
+	clave_valor_t* ranura = abierto_ranura(hash, pos);
 
-	lista_t* lista = hash->datos[posicion];
-	lista_iter_t* iter = lista_iter_crear(lista);
+	return abierto_clave_corta(ranura->largo) ? ranura : ranura->siguiente;
+}
 
-	if (!hash_buscar(hash, clave, iter)) {
+// Devuelve los 7 bits del hash que se guardan en el byte de control.
+static uint8_t abierto_h2(uint64_t h) {
 
-		clave_valor_t* nuevo_nodo = hash_crear_nodo(clave, dato);
+	return h & 0x7F;
+}
 
-		if (nuevo_nodo == NULL)
-			
-			salida = false;
+// Devuelve una máscara con un bit encendido por cada byte del grupo igual a valor.
+static unsigned grupo_coincidencias(const uint8_t* grupo, uint8_t valor) {
 
-		else {
-			
-			lista_insertar_primero(lista, nuevo_nodo);
-			(hash->cantidad_elementos)++;
-		}
+#ifdef __SSE2__
+	__m128i control = _mm_loadu_si128((const __m128i*) grupo);
+	__m128i buscado = _mm_set1_epi8((char) valor);
 
-	} else {
+	return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(control, buscado));
+#else
+	unsigned mascara = 0;
 
-		clave_valor_t* aux = lista_iter_ver_actual(iter);
+	for (int i = 0; i < TAM_GRUPO; i++) {
 
-		if (hash->destruir_dato) hash->destruir_dato(aux->valor);
-		
-		aux->valor = dato;
+		if (grupo[i] == valor) mascara |= 1u << i;
 	}
 
-	lista_iter_destruir(iter);
+	return mascara;
+#endif
+}
 
-	return salida;
+// Devuelve una máscara con las posiciones del grupo vacías o borradas.
+static unsigned grupo_libres(const uint8_t* grupo) {
+
+#ifdef __SSE2__
+	__m128i control = _mm_loadu_si128((const __m128i*) grupo);
+
+	return (unsigned) _mm_movemask_epi8(control);
+#else
+	unsigned mascara = 0;
+
+	for (int i = 0; i < TAM_GRUPO; i++) {
+
+		if (grupo[i] & 0x80) mascara |= 1u << i;
+	}
+
+	return mascara;
+#endif
 }
 
-void* hash_borrar_dato(hash_t *hash, const char *clave) {
+// Busca una clave en la tabla abierta.
+// Devuelve la posición de la ranura o NO_ENCONTRADO.
+static size_t abierto_buscar(const hash_t* hash, const char* clave, size_t largo, uint64_t h) {
+
+	size_t cant_grupos = hash->tamanio / TAM_GRUPO;
+	size_t grupo = (h >> 7) & (cant_grupos - 1);
+	uint8_t h2 = abierto_h2(h);
+
+	CONTAR(hash, busquedas);
+
+	for (size_t salto = 1; salto <= cant_grupos; salto++) {
 
-	void* salida = NULL;
+		const uint8_t* control = hash->control + grupo * TAM_GRUPO;
+		unsigned mascara = grupo_coincidencias(control, h2);
 
-	size_t posicion = hash->fhash(clave, hash->tamanio);
+		while (mascara) {
 
-	lista_t* lista = hash->datos[posicion];
-	lista_iter_t* iter = lista_iter_crear(lista);
+			size_t pos = grupo * TAM_GRUPO + __builtin_ctz(mascara);
 
-	if (hash_buscar(hash, clave, iter)) {
+			if (nodo_es_clave(hash, abierto_nodo(hash, pos), clave, largo, h)) return pos;
 
-		clave_valor_t* aux = lista_borrar(lista, iter);
-		salida = aux->valor;
-		free(aux->clave);
-		free(aux);
+			mascara &= mascara - 1;
+		}
+
+		if (grupo_coincidencias(control, CONTROL_VACIO)) return NO_ENCONTRADO;
+
+		grupo = (grupo + salto) & (cant_grupos - 1);
 	}
 
-	if (salida != NULL) (hash->cantidad_elementos)--;
+	return NO_ENCONTRADO;
+}
+
+// Devuelve la primera ranura vacía o borrada en la secuencia de sondeo del hash.
+// Pre: la tabla tiene al menos una ranura libre.
+static size_t abierto_ranura_libre(const uint8_t* control, size_t tamanio, uint64_t h) {
 
-	lista_iter_destruir(iter);
+	size_t cant_grupos = tamanio / TAM_GRUPO;
+	size_t grupo = (h >> 7) & (cant_grupos - 1);
+	size_t salto = 1;
+	unsigned mascara;
 
-	return salida;
+	while (!(mascara = grupo_libres(control + grupo * TAM_GRUPO))) {
+
+		grupo = (grupo + salto) & (cant_grupos - 1);
+		salto++;
+	}
+
+	return grupo * TAM_GRUPO + __builtin_ctz(mascara);
 }
 
-bool hash_borrar(hash_t *hash, const char *clave) {
+// Devuelve la próxima ranura ocupada a partir de la posición inicial (inclusive).
+static size_t abierto_proxima_ranura(const hash_t* hash, size_t posicion_inicial) {
 
-	return (hash_borrar_dato(hash, clave) != NULL);
+	size_t i = posicion_inicial;
+
+	while ((i < hash->tamanio) && (hash->control[i] & 0x80))
+		i++;
+
+	return i;
 }
 
-void* hash_obtener(const hash_t *hash, const char *clave) {
+// Devuelve el menor tamaño de la tabla abierta en el que entran 'cantidad'
+// elementos dejando al menos un octavo de las ranuras vacías.
+static size_t abierto_tamanio_para(size_t cantidad) {
+
+	size_t tamanio = TAM_INICIAL_ABIERTO;
+
+	while ((cantidad + 1) * 8 > tamanio * 7)
+		tamanio *= 2;
+
+	return tamanio;
+}
 
-	size_t posicion = hash->fhash(clave, hash->tamanio);
+// Guarda la clave con su valor en la ranura pos, que tiene que estar
+// libre. Devuelve false si la clave es larga y no hubo memoria para su nodo.
+static bool abierto_llenar_ranura(hash_t* hash, size_t pos, const char* clave, size_t largo, uint64_t h, void* dato) {
 
-	lista_t* lista = hash->datos[posicion];
-	lista_iter_t* iter = lista_iter_crear(lista);
+	clave_valor_t* ranura = abierto_ranura(hash, pos);
 
-	if (hash_buscar(hash, clave, iter)) {
-		
-		clave_valor_t* aux = lista_iter_ver_actual(iter);
-		lista_iter_destruir(iter);
-		return aux->valor;
+	if (abierto_clave_corta(largo)) {
+
+		memcpy(ranura->clave, clave, largo);
+		ranura->clave[largo] = '\0';
+		ranura->valor = dato;
+		ranura->uso = hash->marca;
+		ranura->siguiente = NULL;
+
+	} else if (!(ranura->siguiente = hash_crear_nodo(hash, clave, largo, h, dato))) {
+		return false;
 	}
 
-	lista_iter_destruir(iter);
+	ranura->hash = h;
+	ranura->largo = (uint32_t) largo;
 
-	return NULL;
+	return true;
 }
 
-bool hash_pertenece(const hash_t *hash, const char *clave) {
+// Vacía la ranura ocupada pos, liberando el nodo si la clave es larga, y
+// devuelve el valor que guardaba.
+static void* abierto_vaciar_ranura(hash_t* hash, size_t pos) {
+
+	clave_valor_t* ranura = abierto_ranura(hash, pos);
 
-	size_t posicion = hash->fhash(clave, hash->tamanio);
+	return abierto_clave_corta(ranura->largo) ? ranura->valor : hash_destuir_nodo(ranura->siguiente);
+}
 
-	lista_t* lista = hash->datos[posicion];
-	lista_iter_t* iter = lista_iter_crear(lista);
+// Reserva e inicializa los arreglos de la tabla abierta. Las ranuras se
+// alinean a su tamaño para que cada una caiga en una sola línea de memoria.
+static bool abierto_inicializar(hash_t* hash, size_t tamanio) {
 
-	bool salida = hash_buscar(hash, clave, iter);
-	lista_iter_destruir(iter);
+	uint8_t* control = malloc(sizeof(uint8_t) * tamanio);
 
-	return salida;
+	if (!control) return false;
+
+	void* ranuras;
+
+	if (posix_memalign(&ranuras, TAM_RANURA, (size_t) TAM_RANURA * tamanio) != 0) {
+		free(control);
+		return false;
+	}
+
+	memset(control, CONTROL_VACIO, tamanio);
+
+	hash->control = control;
+	hash->ranuras = ranuras;
+	hash->tamanio = tamanio;
+	hash->borrados = 0;
+
+	return true;
 }
 
-size_t hash_cantidad(const hash_t *hash) {
+// Redimensiona la tabla abierta, descartando además los borrados.
+static bool abierto_redimensionar(hash_t* hash, size_t nuevo_tamanio) {
 
-	return hash->cantidad_elementos;
+	uint8_t* control_viejo = hash->control;
+	char* ranuras_viejas = hash->ranuras;
+	size_t tamanio_viejo = hash->tamanio;
+
+	if (!abierto_inicializar(hash, nuevo_tamanio)) return false;
+
+	for (size_t i = 0; i < tamanio_viejo; i++) {
+
+		if (control_viejo[i] & 0x80) continue;
+
+		const char* vieja = ranuras_viejas + i * TAM_RANURA;
+		uint64_t h = ((const clave_valor_t*) vieja)->hash;
+		size_t pos = abierto_ranura_libre(hash->control, nuevo_tamanio, h);
+
+		hash->control[pos] = abierto_h2(h);
+		memcpy(abierto_ranura(hash, pos), vieja, TAM_RANURA);
+	}
+
+	free(control_viejo);
+	free(ranuras_viejas);
+	(hash->redimensiones)++;
+
+	return true;
 }
 
-lista_t* hash_claves(const hash_t* hash) {
+static bool hash_abierto_guardar(hash_t* hash, const char* clave, size_t largo, uint64_t h, void* dato) {
 
-	lista_t* lista = lista_crear();
+	size_t pos = abierto_buscar(hash, clave, largo, h);
 
-	int i = 0;
-	
-	while (i < hash->tamanio) {
-		
-		lista_t* lista_aux = hash->datos[i];
-		
-		if (lista_esta_vacia(lista_aux)) {
-			
-			i++;
+	if (pos != NO_ENCONTRADO) {
 
-		} else {
+		clave_valor_t* aux = abierto_nodo(hash, pos);
 
-			lista_iter_t* iter = lista_iter_crear(lista_aux);
-			
-			while (!lista_iter_al_final(iter)) {
-
-				clave_valor_t* clave_valor = lista_iter_ver_actual(iter);
-				lista_insertar_primero(lista, clave_valor->clave);
-				lista_iter_avanzar(iter);
-			}
-			
-			i++;
-			
-			lista_iter_destruir(iter);
-		}
+		if (hash->destruir_dato) hash->destruir_dato(aux->valor);
+
+		aux->valor = dato;
 
+		return true;
 	}
 
-	return lista;
+	// Se mantiene el factor de carga (elementos más borrados) por debajo de 7/8.
+	// Si la mayor parte de las ranuras no libres son borrados, se reconstruye
+	// con el mismo tamaño en lugar de duplicarlo.
+	if ((hash->cantidad_elementos + hash->borrados + 1) * 8 > hash->tamanio * 7) {
+
+		size_t nuevo_tamanio = hash->tamanio;
+
+		if (hash->cantidad_elementos >= hash->tamanio / 2) nuevo_tamanio *= 2;
+
+		if (!abierto_redimensionar(hash, nuevo_tamanio)) return false;
+	}
+
+	pos = abierto_ranura_libre(hash->control, hash->tamanio, h);
+
+	if (!abierto_llenar_ranura(hash, pos, clave, largo, h, dato)) return false;
+
+	if (hash->control[pos] == CONTROL_BORRADO) (hash->borrados)--;
+
+	hash->control[pos] = abierto_h2(h);
+	(hash->cantidad_elementos)++;
+
+	return true;
 }
 
-void hash_destruir(hash_t *hash) {
+static void* hash_abierto_borrar_dato(hash_t* hash, const char* clave, size_t largo, uint64_t h) {
 
-	void* aux_valor;
+	size_t pos = abierto_buscar(hash, clave, largo, h);
 
-	hash_destruir_dato_t destruir_dato = hash->destruir_dato;
+	if (pos == NO_ENCONTRADO) return NULL;
 
-	for (int i = 0; i < hash->tamanio; i++) {
+	void* dato = abierto_vaciar_ranura(hash, pos);
 
-		while (!lista_esta_vacia(hash->datos[i])) {
+	hash->control[pos] = CONTROL_BORRADO;
+	(hash->borrados)++;
+	(hash->cantidad_elementos)--;
 
-			aux_valor = hash_destuir_nodo(lista_borrar_primero(hash->datos[i]));
+	// Si no hay memoria para achicarla, la tabla sigue funcionando igual.
+	if (factor_hash_insuficiente(hash)) abierto_redimensionar(hash, hash->tamanio / 2);
 
-			if (destruir_dato) destruir_dato(aux_valor);
-		}
+	return dato;
+}
+
+static void hash_abierto_destruir(hash_t* hash) {
+
+	void* aux_valor;
+
+	for (size_t i = 0; i < hash->tamanio; i++) {
+
+		if (hash->control[i] & 0x80) continue;
 
-		lista_destruir(hash->datos[i], NULL);
+		aux_valor = abierto_vaciar_ranura(hash, i);
+
+		if (hash->destruir_dato) hash->destruir_dato(aux_valor);
 	}
 
-	free(hash->datos);
+	free(hash->control);
+	free(hash->ranuras);
 	free(hash);
 }
 
 /* ******************************************************************
- *                    PRIMITIVAS DEL ITERADOR
+ *                FUNCIONES AUXILIARES DE LA TABLA ORDENADA
  * *****************************************************************/
 
-hash_iter_t *hash_iter_crear(const hash_t *hash) {
+/* La tabla ordenada guarda los nodos en un arreglo denso ('entradas'), en
+ * el orden en que se insertaron, y un índice de 'tamanio' ranuras
+ * (direccionamiento abierto con sondeo lineal) con la posición de cada
+ * nodo en ese arreglo. Borrar deja un hueco (NULL) en el arreglo, que se
+ * descarta la próxima vez que la tabla se reconstruye. */
 
-	size_t proximo_elemento;
-	hash_iter_t* iter_nuevo = malloc(sizeof(hash_iter_t));
+// Devuelve cuántas entradas tiene el arreglo de una tabla cuyo índice
+// tiene 'tamanio' ranuras.
+static size_t ordenado_capacidad(size_t tamanio) {
 
-	if (!iter_nuevo) return NULL;
+	return tamanio * 2 / 3;
+}
 
-	iter_nuevo->posicion_actual = 0;
-	iter_nuevo->al_final = true;
-	proximo_elemento = hash_proximo_elemento(hash,-1);
+// Devuelve el menor tamaño del índice con lugar para 'cantidad' entradas.
+static size_t ordenado_tamanio_para(size_t cantidad) {
 
-	if (proximo_elemento != hash->tamanio) {
+	size_t tamanio = TAM_INICIAL_ORDENADO;
 
-		iter_nuevo->posicion_actual = proximo_elemento;
-		iter_nuevo->al_final = false;
+	while (ordenado_capacidad(tamanio) < cantidad)
+		tamanio *= 2;
+
+	return tamanio;
+}
+
+// Busca una clave en la tabla ordenada.
+// Devuelve la posición del índice que apunta a su entrada o NO_ENCONTRADO.
+static size_t ordenado_buscar(const hash_t* hash, const char* clave, size_t largo, uint64_t h) {
+
+	size_t mascara = hash->tamanio - 1;
+
+	CONTAR(hash, busquedas);
+
+	for (size_t i = h & mascara; hash->indice[i] != INDICE_VACIO; i = (i + 1) & mascara) {
+
+		if (hash->indice[i] == INDICE_BORRADO) continue;
+
+		if (nodo_es_clave(hash, hash->entradas[hash->indice[i]], clave, largo, h)) return i;
 	}
 
-	iter_nuevo->hash = hash;
-	iter_nuevo->lista_iter = lista_iter_crear(hash->datos[iter_nuevo->posicion_actual]);
+	return NO_ENCONTRADO;
+}
 
-	return iter_nuevo;
+// Devuelve la primera ranura vacía o borrada del índice en la secuencia de
+// sondeo del hash. Siempre hay una, porque el índice tiene más ranuras que
+// el arreglo de entradas.
+static size_t ordenado_ranura_libre(const size_t* indice, size_t tamanio, uint64_t h) {
+
+	size_t mascara = tamanio - 1;
+	size_t i = h & mascara;
+
+	while (indice[i] != INDICE_VACIO && indice[i] != INDICE_BORRADO)
+		i = (i + 1) & mascara;
+
+	return i;
 }
 
-bool hash_iter_avanzar(hash_iter_t *iter) {
+// Devuelve la próxima entrada no borrada a partir de la posición inicial (inclusive).
+static size_t ordenado_proxima_entrada(const hash_t* hash, size_t posicion_inicial) {
 
-	if (iter->al_final) return false;
+	size_t i = posicion_inicial;
+
+	while ((i < hash->usadas) && !hash->entradas[i])
+		i++;
 
-	size_t proximo_elemento = 0;
+	return i;
+}
 
-	lista_iter_avanzar(iter->lista_iter);
+// Devuelve el tamaño con el que se reconstruye la tabla ordenada: deja
+// lugar para tantas entradas nuevas como elementos tiene.
+static size_t ordenado_tamanio_destino(const hash_t* hash) {
 
-	if (lista_iter_al_final(iter->lista_iter)) {
+	size_t tamanio = ordenado_tamanio_para(2 * hash->cantidad_elementos);
 
-		proximo_elemento = hash_proximo_elemento(iter->hash,iter->posicion_actual);
+	return (tamanio > hash->tamanio_minimo) ? tamanio : hash->tamanio_minimo;
+}
 
-		if (proximo_elemento != iter->hash->tamanio) {
+// Reconstruye la tabla ordenada con un índice de nuevo_tamanio ranuras,
+// juntando las entradas al principio del arreglo sin cambiar su orden.
+static bool ordenado_redimensionar(hash_t* hash, size_t nuevo_tamanio) {
 
-			lista_iter_destruir(iter->lista_iter);
-			iter->posicion_actual = proximo_elemento;
-			iter->lista_iter = lista_iter_crear(iter->hash->datos[iter->posicion_actual]);
+	size_t* indice = malloc(sizeof(size_t) * nuevo_tamanio);
 
-		} else {
+	if (!indice) return false;
 
-			iter->al_final = true;
-			return false;
-		}
+	clave_valor_t* *entradas = malloc(sizeof(clave_valor_t*) * ordenado_capacidad(nuevo_tamanio));
+
+	if (!entradas) {
+		free(indice);
+		return false;
+	}
+
+	for (size_t i = 0; i < nuevo_tamanio; i++)
+		indice[i] = INDICE_VACIO;
+
+	size_t usadas = 0;
+
+	for (size_t i = 0; i < hash->usadas; i++) {
+
+		clave_valor_t* nodo = hash->entradas[i];
+
+		if (!nodo) continue;
+
+		indice[ordenado_ranura_libre(indice, nuevo_tamanio, nodo->hash)] = usadas;
+		entradas[usadas++] = nodo;
+	}
+
+	free(hash->indice);
+	free(hash->entradas);
+
+	hash->indice = indice;
+	hash->entradas = entradas;
+	hash->tamanio = nuevo_tamanio;
+	hash->usadas = usadas;
+	(hash->redimensiones)++;
+
+	return true;
+}
+
+static bool hash_ordenado_guardar(hash_t* hash, const char* clave, size_t largo, uint64_t h, void* dato) {
+
+	size_t pos = ordenado_buscar(hash, clave, largo, h);
+
+	// Reemplazar el valor no cambia la posición de la clave en el orden.
+	if (pos != NO_ENCONTRADO) {
+
+		clave_valor_t* aux = hash->entradas[hash->indice[pos]];
+
+		if (hash->destruir_dato) hash->destruir_dato(aux->valor);
+
+		aux->valor = dato;
+
+		return true;
+	}
+
+	// Con el arreglo lleno se reconstruye: si la mitad de las entradas o
+	// más son huecos, basta con juntarlas; si no, la tabla crece.
+	if (hash->usadas == ordenado_capacidad(hash->tamanio)) {
+
+		if (!ordenado_redimensionar(hash, ordenado_tamanio_destino(hash))) return false;
+	}
+
+	clave_valor_t* nuevo_nodo = hash_crear_nodo(hash, clave, largo, h, dato);
+
+	if (!nuevo_nodo) return false;
+
+	hash->indice[ordenado_ranura_libre(hash->indice, hash->tamanio, h)] = hash->usadas;
+	hash->entradas[(hash->usadas)++] = nuevo_nodo;
+	(hash->cantidad_elementos)++;
+
+	return true;
+}
+
+static void* hash_ordenado_borrar_dato(hash_t* hash, const char* clave, size_t largo, uint64_t h) {
+
+	size_t pos = ordenado_buscar(hash, clave, largo, h);
+
+	if (pos == NO_ENCONTRADO) return NULL;
+
+	size_t entrada = hash->indice[pos];
+	void* dato = hash_destuir_nodo(hash->entradas[entrada]);
+
+	hash->entradas[entrada] = NULL;
+	hash->indice[pos] = INDICE_BORRADO;
+	(hash->cantidad_elementos)--;
+
+	// Cuando la mitad de las entradas usadas son huecos, se juntan (y la
+	// tabla se achica si le sobra lugar). Si no hay memoria, sigue
+	// funcionando igual.
+	if (hash->cantidad_elementos * 2 <= hash->usadas)
+		ordenado_redimensionar(hash, ordenado_tamanio_destino(hash));
+
+	return dato;
+}
+
+static void hash_ordenado_destruir(hash_t* hash) {
+
+	for (size_t i = 0; i < hash->usadas; i++) {
+
+		if (!hash->entradas[i]) continue;
+
+		void* aux_valor = hash_destuir_nodo(hash->entradas[i]);
+
+		if (hash->destruir_dato) hash->destruir_dato(aux_valor);
+	}
+
+	free(hash->indice);
+	free(hash->entradas);
+	free(hash);
+}
+
+/* ******************************************************************
+ *                FUNCIONES AUXILIARES DE LA TABLA MAPEADA
+ * *****************************************************************/
+
+// Redondea un desplazamiento al múltiplo de 8 siguiente.
+static uint64_t alinear(uint64_t desplazamiento) {
+
+	return (desplazamiento + 7) & ~(uint64_t) 7;
+}
+
+// Devuelve la ranura i del índice de la imagen.
+static const imagen_ranura_t* mapeado_ranura(const hash_t* hash, size_t i) {
+
+	return (const imagen_ranura_t*) (hash->imagen + sizeof(imagen_encabezado_t)) + i;
+}
+
+// Devuelve la entrada de la imagen ubicada en el desplazamiento recibido, o
+// NULL si es una ranura libre o si la entrada (con su clave terminada en
+// '\0' y su valor) no cae entera dentro de la imagen. La imagen no se
+// revisa al mapearla, así que una truncada o corrupta se detecta acá.
+static const imagen_entrada_t* mapeado_entrada(const hash_t* hash, uint64_t desplazamiento) {
+
+	uint64_t inicio = sizeof(imagen_encabezado_t) + hash->tamanio * sizeof(imagen_ranura_t);
+
+	if (desplazamiento < inicio || (desplazamiento & 7) != 0 ||
+		desplazamiento > hash->largo_imagen - sizeof(imagen_entrada_t)) return NULL;
+
+	const imagen_entrada_t* entrada = (const imagen_entrada_t*) (hash->imagen + desplazamiento);
+	uint64_t disponible = hash->largo_imagen - desplazamiento - sizeof(imagen_entrada_t);
+
+	// La clave ocupa su largo más el '\0', redondeado a 8 bytes, que puede
+	// pasarse de lo disponible aunque la clave entre.
+	if (entrada->largo_clave >= disponible || alinear(entrada->largo_clave + 1) > disponible ||
+		entrada->clave[entrada->largo_clave] != '\0') return NULL;
+
+	disponible -= alinear(entrada->largo_clave + 1);
+
+	if (entrada->largo_valor > disponible) return NULL;
+
+	return entrada;
+}
+
+// Devuelve el valor guardado en una entrada de la imagen.
+static void* mapeado_valor(const imagen_entrada_t* entrada) {
+
+	return (char*) entrada + sizeof(imagen_entrada_t) + alinear(entrada->largo_clave + 1);
+}
+
+// Busca una clave en la imagen. Devuelve su entrada o NULL.
+// Recorre a lo sumo 'tamanio' ranuras, por si la imagen no tiene libres.
+static const imagen_entrada_t* mapeado_buscar(const hash_t* hash, const char* clave, size_t largo, uint64_t h) {
+
+	size_t mascara = hash->tamanio - 1;
+
+	CONTAR(hash, busquedas);
+
+	for (size_t i = h & mascara, sondeos = 0; sondeos < hash->tamanio; i = (i + 1) & mascara, sondeos++) {
+
+		const imagen_ranura_t* ranura = mapeado_ranura(hash, i);
+
+		if (ranura->desplazamiento == 0) return NULL;
+
+		CONTAR(hash, sondeos);
+
+		if (ranura->hash != h) continue;
+
+		const imagen_entrada_t* entrada = mapeado_entrada(hash, ranura->desplazamiento);
+
+		if (!entrada || entrada->largo_clave != largo) continue;
+
+		CONTAR(hash, comparaciones);
+
+		if (memcmp(entrada->clave, clave, largo) == 0) return entrada;
+	}
+
+	return NULL;
+}
+
+// Devuelve la próxima ranura ocupada del índice a partir de la posición
+// inicial (inclusive), salteando las que apuntan a entradas inválidas.
+static size_t mapeado_proxima_ranura(const hash_t* hash, size_t posicion_inicial) {
+
+	size_t i = posicion_inicial;
+
+	while ((i < hash->tamanio) && !mapeado_entrada(hash, mapeado_ranura(hash, i)->desplazamiento))
+		i++;
+
+	return i;
+}
+
+// Escribe en el archivo los bytes acumulados en el búfer y lo vacía.
+static bool escritor_vaciar(escritor_t* escritor) {
+
+	size_t escritos = 0;
+
+	while (escritos < escritor->usados) {
+
+		ssize_t n = write(escritor->fd, escritor->bufer + escritos, escritor->usados - escritos);
+
+		if (n < 0 && errno == EINTR) continue;
+
+		if (n <= 0) return false;
+
+		escritos += n;
+	}
+
+	escritor->usados = 0;
+
+	return true;
+}
+
+// Agrega bytes al archivo pasando por el búfer del escritor.
+static bool escritor_escribir(escritor_t* escritor, const void* datos, size_t largo) {
+
+	const char* bytes = datos;
+
+	while (largo > 0) {
+
+		if (escritor->usados == TAM_BUFER_ESCRITURA && !escritor_vaciar(escritor)) return false;
+
+		size_t libres = TAM_BUFER_ESCRITURA - escritor->usados;
+		size_t copiar = (largo < libres) ? largo : libres;
+
+		memcpy(escritor->bufer + escritor->usados, bytes, copiar);
+		escritor->usados += copiar;
+		bytes += copiar;
+		largo -= copiar;
+	}
+
+	return true;
+}
+
+// Agrega ceros hasta alinear el desplazamiento a 8 bytes.
+static bool escritor_rellenar(escritor_t* escritor, uint64_t desplazamiento) {
+
+	static const char ceros[8] = { 0 };
+
+	return escritor_escribir(escritor, ceros, alinear(desplazamiento) - desplazamiento);
+}
+
+// Visitante de hash_iterar_entradas que anota cada elemento del hash en el arreglo.
+static bool agregar_a_serializacion(const char* clave, size_t largo, void* dato, void* extra) {
+
+	serializacion_t* serializacion = extra;
+	elemento_serializado_t* elemento = &serializacion->elementos[(serializacion->cantidad)++];
+
+	elemento->clave = clave;
+	elemento->largo_clave = largo;
+	elemento->valor = NULL;
+	elemento->largo_valor = 0;
+
+	if (serializacion->serializar_dato)
+		elemento->valor = serializacion->serializar_dato(dato, &elemento->largo_valor);
+
+	return true;
+}
+
+/* ******************************************************************
+ *              FUNCIONES AUXILIARES CON EL HASH YA CALCULADO
+ * *****************************************************************/
+
+// Guarda una clave cuyo largo y hash ya fueron calculados, sin tener en
+// cuenta el filtro (ver hash_guardar_calculado).
+static bool hash_guardar_en_tabla(hash_t* hash, const char* clave, size_t largo, uint64_t h, void* dato) {
+
+	if (hash->tipo == HASH_MAPEADO || largo > UINT32_MAX) return false;
+
+	if (hash->tipo == HASH_ABIERTO) return hash_abierto_guardar(hash, clave, largo, h, dato);
+
+	if (hash->tipo == HASH_ORDENADO) return hash_ordenado_guardar(hash, clave, largo, h, dato);
+
+	hash_migrar(hash, BALDES_POR_PASO);
+
+	if (factor_hash_superado(hash)) {
+
+		if (!hash_redimensionar(hash, hash->tamanio * FACTOR_MULTIPLICACION)) return false;
+	}
+
+	clave_valor_t* *balde = hash_balde(hash, h);
+	clave_valor_t* *lugar = hash_buscar(hash, balde, clave, largo, h);
+
+	if (*lugar) {
+
+		if (hash->destruir_dato) hash->destruir_dato((*lugar)->valor);
+
+		(*lugar)->valor = dato;
+
+		return true;
+	}
+
+	clave_valor_t* nuevo_nodo = hash_crear_nodo(hash, clave, largo, h, dato);
+
+	if (!nuevo_nodo) return false;
+
+	nuevo_nodo->siguiente = *balde;
+	*balde = nuevo_nodo;
+	(hash->cantidad_elementos)++;
+
+	return true;
+}
+
+// Borra una clave cuyo largo y hash ya fueron calculados, sin tener en
+// cuenta el presupuesto (ver hash_borrar_calculado).
+// Devuelve el dato asociado o NULL si no estaba.
+static void* hash_borrar_de_tabla(hash_t* hash, const char* clave, size_t largo, uint64_t h) {
+
+	if (hash->tipo == HASH_MAPEADO) return NULL;
+
+	if (hash->tipo == HASH_ABIERTO) return hash_abierto_borrar_dato(hash, clave, largo, h);
+
+	if (hash->tipo == HASH_ORDENADO) return hash_ordenado_borrar_dato(hash, clave, largo, h);
+
+	hash_migrar(hash, BALDES_POR_PASO);
+
+	clave_valor_t* *lugar = hash_buscar(hash, hash_balde(hash, h), clave, largo, h);
+
+	if (!*lugar) return NULL;
+
+	clave_valor_t* nodo = *lugar;
+	*lugar = nodo->siguiente;
+	(hash->cantidad_elementos)--;
+
+	// Mientras dura una mudanza no se achica, para no tener que completarla.
+	if (!hash->datos_viejos && factor_hash_insuficiente(hash))
+		hash_redimensionar(hash, hash->tamanio / FACTOR_MULTIPLICACION);
+
+	return hash_destuir_nodo(nodo);
+}
+
+// Busca el nodo de una clave cuyo largo y hash ya fueron calculados, en
+// una tabla que no es una imagen mapeada. Devuelve NULL si no está.
+static clave_valor_t* hash_nodo_calculado(const hash_t* hash, const char* clave, size_t largo, uint64_t h) {
+
+	if (hash->tipo == HASH_ABIERTO) {
+
+		size_t pos = abierto_buscar(hash, clave, largo, h);
+
+		return (pos != NO_ENCONTRADO) ? abierto_nodo(hash, pos) : NULL;
+	}
+
+	if (hash->tipo == HASH_ORDENADO) {
+
+		size_t pos = ordenado_buscar(hash, clave, largo, h);
+
+		return (pos != NO_ENCONTRADO) ? hash->entradas[hash->indice[pos]] : NULL;
+	}
+
+	return *hash_buscar(hash, hash_balde(hash, h), clave, largo, h);
+}
+
+// Busca una clave cuyo largo y hash ya fueron calculados.
+// Devuelve true si la encontró, dejando en 'valor' el dato asociado.
+static bool hash_obtener_calculado(const hash_t* hash, const char* clave, size_t largo, uint64_t h, void* *valor) {
+
+	// Si el filtro descarta la clave, no hace falta mirar la tabla.
+	if (hash->filtro && !bloom_puede_contener_hash(hash->filtro, h)) {
+		*valor = NULL;
+		return false;
+	}
+
+	if (hash->tipo == HASH_MAPEADO) {
+
+		const imagen_entrada_t* entrada = mapeado_buscar(hash, clave, largo, h);
+
+		*valor = entrada ? mapeado_valor(entrada) : NULL;
+
+		return (entrada != NULL);
+	}
+
+	clave_valor_t* nodo = hash_nodo_calculado(hash, clave, largo, h);
+
+	// Sólo se escribe el nodo si cambia su marca: en las tablas sin
+	// presupuesto, la marca es siempre 0.
+	if (nodo && nodo->uso != hash->marca) nodo->uso = hash->marca;
+
+	*valor = nodo ? nodo->valor : NULL;
+
+	return (nodo != NULL);
+}
+
+// Precarga la primera línea de memoria que va a leer la búsqueda del hash h.
+static void hash_precargar_balde(const hash_t* hash, uint64_t h) {
+
+	if (hash->tipo == HASH_MAPEADO) {
+		PRECARGAR(mapeado_ranura(hash, h & (hash->tamanio - 1)));
+		return;
+	}
+
+	if (hash->tipo == HASH_ABIERTO) {
+
+		size_t cant_grupos = hash->tamanio / TAM_GRUPO;
+		PRECARGAR(hash->control + ((h >> 7) & (cant_grupos - 1)) * TAM_GRUPO);
+		return;
+	}
+
+	if (hash->tipo == HASH_ORDENADO) {
+		PRECARGAR(&hash->indice[h & (hash->tamanio - 1)]);
+		return;
+	}
+
+	PRECARGAR(hash_balde(hash, h));
+}
+
+// Precarga el primer nodo candidato del hash h. Para la tabla encadenada es
+// la cabeza de la cadena; para la abierta, la ranura de la primera
+// coincidencia de su byte de control.
+static void hash_precargar_nodo(const hash_t* hash, uint64_t h) {
+
+	if (hash->tipo == HASH_MAPEADO) {
+
+		const imagen_ranura_t* ranura = mapeado_ranura(hash, h & (hash->tamanio - 1));
+
+		if (ranura->desplazamiento < hash->largo_imagen) PRECARGAR(hash->imagen + ranura->desplazamiento);
+		return;
+	}
+
+	if (hash->tipo == HASH_ABIERTO) {
+
+		size_t cant_grupos = hash->tamanio / TAM_GRUPO;
+		size_t grupo = (h >> 7) & (cant_grupos - 1);
+		unsigned mascara = grupo_coincidencias(hash->control + grupo * TAM_GRUPO, abierto_h2(h));
+
+		if (mascara) PRECARGAR(abierto_ranura(hash, grupo * TAM_GRUPO + __builtin_ctz(mascara)));
+		return;
+	}
+
+	if (hash->tipo == HASH_ORDENADO) {
+
+		size_t entrada = hash->indice[h & (hash->tamanio - 1)];
+
+		if (entrada < hash->usadas) PRECARGAR(hash->entradas[entrada]);
+		return;
+	}
+
+	PRECARGAR(*hash_balde(hash, h));
+}
+
+// Visitante de hash_iterar que agrega cada clave al principio de una lista.
+static bool agregar_clave_a_lista(const char* clave, void* dato, void* extra) {
+
+	lista_insertar_primero(extra, (void*) clave);
+
+	return true;
+}
+
+// Visitante de hash_iterar que copia cada clave al arreglo hasta llenarlo.
+static bool agregar_clave_a_arreglo(const char* clave, void* dato, void* extra) {
+
+	arreglo_claves_t* arreglo = extra;
+
+	arreglo->claves[(arreglo->cantidad)++] = clave;
+
+	return arreglo->cantidad < arreglo->tam;
+}
+
+// Recorre todas las entradas del hash, pasándole a visitar también el largo
+// de cada clave (que puede ser binaria).
+static void hash_iterar_entradas(const hash_t *hash, visitar_entrada_t visitar, void *extra) {
+
+	if (hash->tipo == HASH_MAPEADO) {
+
+		size_t i = mapeado_proxima_ranura(hash, 0);
+
+		while (i < hash->tamanio) {
+
+			const imagen_entrada_t* entrada = mapeado_entrada(hash, mapeado_ranura(hash, i)->desplazamiento);
+
+			if (!visitar(entrada->clave, entrada->largo_clave, mapeado_valor(entrada), extra)) return;
+
+			i = mapeado_proxima_ranura(hash, i + 1);
+		}
+
+		return;
+	}
+
+	if (hash->tipo == HASH_ABIERTO) {
+
+		size_t i = abierto_proxima_ranura(hash, 0);
+
+		while (i < hash->tamanio) {
+
+			clave_valor_t* nodo = abierto_nodo(hash, i);
+
+			if (!visitar(nodo->clave, nodo->largo, nodo->valor, extra)) return;
+
+			i = abierto_proxima_ranura(hash, i + 1);
+		}
+
+		return;
+	}
+
+	if (hash->tipo == HASH_ORDENADO) {
+
+		for (size_t i = ordenado_proxima_entrada(hash, 0); i < hash->usadas; i = ordenado_proxima_entrada(hash, i + 1)) {
+
+			clave_valor_t* nodo = hash->entradas[i];
+
+			if (!visitar(nodo->clave, nodo->largo, nodo->valor, extra)) return;
+		}
+
+		return;
+	}
+
+	for (size_t i = 0; i < hash_cantidad_baldes(hash); i++) {
+
+		for (clave_valor_t* nodo = hash_balde_en(hash, i); nodo; nodo = nodo->siguiente) {
+
+			if (!visitar(nodo->clave, nodo->largo, nodo->valor, extra)) return;
+		}
+	}
+}
+
+// Visitante de hash_iterar_entradas que descarta el largo de la clave y
+// llama al visitante recibido por hash_iterar.
+static bool visitar_sin_largo(const char* clave, size_t largo, void* dato, void* extra) {
+
+	visitante_t* visitante = extra;
+
+	return visitante->visitar(clave, dato, visitante->extra);
+}
+
+/* ******************************************************************
+ *                 FUNCIONES AUXILIARES DEL FILTRO
+ * *****************************************************************/
+
+// Visitante de hash_iterar_entradas que agrega cada clave al filtro del hash.
+static bool agregar_a_filtro(const char* clave, size_t largo, void* dato, void* extra) {
+
+	hash_t* hash = extra;
+
+	bloom_agregar_hash(hash->filtro, hash_calcular(hash, clave, largo));
+
+	return true;
+}
+
+// Reemplaza el filtro del hash por uno nuevo con sus claves actuales, con
+// lugar para el doble. Así también se descartan las claves borradas, que
+// un filtro de Bloom no puede quitar. Si no hay memoria, el hash conserva
+// el filtro que tenía.
+static bool filtro_reconstruir(hash_t* hash, size_t bits_por_clave) {
+
+	size_t capacidad = 2 * hash->cantidad_elementos;
+
+	if (capacidad < CAPACIDAD_MINIMA_FILTRO) capacidad = CAPACIDAD_MINIMA_FILTRO;
+
+	bloom_t* nuevo = bloom_crear_bloques(capacidad, bits_por_clave, 0);
+
+	if (!nuevo) return false;
+
+	bloom_t* viejo = hash->filtro;
+
+	hash->filtro = nuevo;
+	hash->bits_filtro = bits_por_clave;
+	hash_iterar_entradas(hash, agregar_a_filtro, hash);
+
+	if (viejo) bloom_destruir(viejo);
+
+	return true;
+}
+
+// Anota en el filtro una clave recién guardada. Si el filtro ya recibió
+// tantas claves como su capacidad, se reconstruye (y la nueva clave ya
+// queda incluida); si no se puede, se sigue usando aunque dé más falsos
+// positivos.
+static void filtro_agregar(hash_t* hash, uint64_t h) {
+
+	if (bloom_cantidad(hash->filtro) >= bloom_capacidad(hash->filtro) && filtro_reconstruir(hash, hash->bits_filtro))
+		return;
+
+	bloom_agregar_hash(hash->filtro, h);
+}
+
+/* ******************************************************************
+ *               FUNCIONES AUXILIARES DEL PRESUPUESTO
+ * *****************************************************************/
+
+// Devuelve los bytes que el presupuesto le cuenta a una entrada: los de su
+// nodo, con la clave, y los de su dato.
+static size_t presupuesto_bytes(const hash_t* hash, size_t largo, const void* dato) {
+
+	size_t bytes = sizeof(clave_valor_t) + largo + 1;
+
+	if (hash->tamanio_dato) bytes += hash->tamanio_dato(dato);
+
+	return bytes;
+}
+
+// Visitante de hash_iterar_entradas que suma al hash los bytes de cada entrada.
+static bool sumar_bytes(const char* clave, size_t largo, void* dato, void* extra) {
+
+	hash_t* hash = extra;
+
+	hash->memoria += presupuesto_bytes(hash, largo, dato);
+
+	return true;
+}
+
+// Generador xorshift64* para elegir posiciones al azar.
+static uint64_t desalojo_azar(hash_t* hash) {
+
+	hash->azar ^= hash->azar >> 12;
+	hash->azar ^= hash->azar << 25;
+	hash->azar ^= hash->azar >> 27;
+
+	return hash->azar * 0x2545f4914f6cdd1dULL;
+}
+
+// Devuelve la cantidad de posiciones en las que se buscan las claves a
+// desalojar: las ranuras de la tabla abierta, las entradas usadas de la
+// ordenada o los baldes (de ambas tablas) de la encadenada.
+static size_t desalojo_posiciones(const hash_t* hash) {
+
+	if (hash->tipo == HASH_ABIERTO) return hash->tamanio;
+
+	if (hash->tipo == HASH_ORDENADO) return hash->usadas;
+
+	return hash_cantidad_baldes(hash);
+}
+
+// Devuelve el primer nodo de la posición i, o NULL si está libre. Sólo en
+// la tabla encadenada puede haber otros, que se recorren con 'siguiente'.
+static clave_valor_t* desalojo_nodo_en(const hash_t* hash, size_t i) {
+
+	if (hash->tipo == HASH_ABIERTO) return (hash->control[i] & 0x80) ? NULL : abierto_nodo(hash, i);
+
+	if (hash->tipo == HASH_ORDENADO) return hash->entradas[i];
+
+	return hash_balde_en(hash, i);
+}
+
+// Verifica si el nodo es el de la clave que no se puede desalojar (la que
+// se acaba de guardar). Si clave es NULL, no hay ninguna.
+static bool desalojo_protegido(const clave_valor_t* nodo, const char* clave, size_t largo, uint64_t h) {
+
+	return clave && nodo->hash == h && nodo->largo == largo && memcmp(nodo->clave, clave, largo) == 0;
+}
+
+// CLOCK: la aguja recorre las posiciones apagando las marcas que encuentra
+// y elige el primer nodo que ya la tenía apagada, es decir, que no se usó
+// desde la vuelta anterior. En dos vueltas siempre encuentra uno.
+static clave_valor_t* desalojo_reloj(hash_t* hash, const char* clave, size_t largo, uint64_t h) {
+
+	size_t posiciones = desalojo_posiciones(hash);
+
+	for (size_t paso = 0; paso <= 2 * posiciones; paso++) {
+
+		if (hash->aguja >= posiciones) hash->aguja = 0;
+
+		for (clave_valor_t* nodo = desalojo_nodo_en(hash, hash->aguja); nodo; nodo = nodo->siguiente) {
+
+			if (desalojo_protegido(nodo, clave, largo, h)) continue;
+
+			if (!nodo->uso) return nodo;
+
+			nodo->uso = 0;
+		}
+
+		(hash->aguja)++;
+	}
+
+	return NULL;
+}
+
+// Elige el primer nodo que aparece a partir de una posición al azar.
+static clave_valor_t* desalojo_aleatorio(hash_t* hash, const char* clave, size_t largo, uint64_t h) {
+
+	size_t posiciones = desalojo_posiciones(hash);
+
+	if (posiciones == 0) return NULL;
+
+	size_t i = desalojo_azar(hash) % posiciones;
+
+	for (size_t paso = 0; paso < posiciones; paso++) {
+
+		for (clave_valor_t* nodo = desalojo_nodo_en(hash, i); nodo; nodo = nodo->siguiente) {
+
+			if (!desalojo_protegido(nodo, clave, largo, h)) return nodo;
+		}
+
+		i = (i + 1 < posiciones) ? i + 1 : 0;
+	}
+
+	return NULL;
+}
+
+// LRU muestreado: entre MUESTRAS_DESALOJO nodos al azar, elige el de marca
+// más vieja. La marca es un reloj que avanza con cada guardado, así que
+// la diferencia con el reloj actual es la antigüedad del último uso.
+static clave_valor_t* desalojo_lru_muestreado(hash_t* hash, const char* clave, size_t largo, uint64_t h) {
+
+	clave_valor_t* victima = NULL;
+
+	for (size_t i = 0; i < MUESTRAS_DESALOJO; i++) {
+
+		clave_valor_t* nodo = desalojo_aleatorio(hash, clave, largo, h);
+
+		if (nodo && (!victima || (uint32_t) (hash->marca - nodo->uso) > (uint32_t) (hash->marca - victima->uso)))
+			victima = nodo;
+	}
+
+	return victima;
+}
+
+// Borra una clave cuyo largo y hash ya fueron calculados.
+// Devuelve el dato asociado o NULL si no estaba.
+static void* hash_borrar_calculado(hash_t* hash, const char* clave, size_t largo, uint64_t h) {
+
+	size_t cantidad = hash->cantidad_elementos;
+	void* dato = hash_borrar_de_tabla(hash, clave, largo, h);
+
+	if (hash->presupuesto && hash->cantidad_elementos < cantidad)
+		hash->memoria -= presupuesto_bytes(hash, largo, dato);
+
+	return dato;
+}
+
+// Desaloja claves según la política del hash hasta que entre en el
+// presupuesto, sin desalojar la clave recibida (si no es NULL).
+static void presupuesto_ajustar(hash_t* hash, const char* clave, size_t largo, uint64_t h) {
+
+	while (hash->memoria > hash->presupuesto && hash->cantidad_elementos > (clave ? 1 : 0)) {
+
+		clave_valor_t* victima;
+
+		if (hash->politica == HASH_DESALOJO_RELOJ) victima = desalojo_reloj(hash, clave, largo, h);
+		else if (hash->politica == HASH_DESALOJO_LRU_MUESTREADO) victima = desalojo_lru_muestreado(hash, clave, largo, h);
+		else victima = desalojo_aleatorio(hash, clave, largo, h);
+
+		if (!victima) return;
+
+		void* dato = hash_borrar_calculado(hash, victima->clave, victima->largo, victima->hash);
+
+		if (hash->destruir_dato) hash->destruir_dato(dato);
+
+		(hash->desalojos)++;
+	}
+}
+
+// Guarda una clave cuyo largo y hash ya fueron calculados.
+static bool hash_guardar_calculado(hash_t* hash, const char* clave, size_t largo, uint64_t h, void* dato) {
+
+	size_t cantidad = hash->cantidad_elementos;
+	size_t bytes_anteriores = 0;
+
+	if (hash->presupuesto) {
+
+		void* anterior;
+
+		// El dato reemplazado se destruye al guardar: hay que medirlo antes.
+		if (cantidad > 0 && hash_obtener_calculado(hash, clave, largo, h, &anterior))
+			bytes_anteriores = presupuesto_bytes(hash, largo, anterior);
+
+		if (hash->politica == HASH_DESALOJO_LRU_MUESTREADO) (hash->marca)++;
+	}
+
+	if (!hash_guardar_en_tabla(hash, clave, largo, h, dato)) return false;
+
+	if (hash->filtro && hash->cantidad_elementos > cantidad) filtro_agregar(hash, h);
+
+	if (hash->presupuesto) {
+
+		hash->memoria = hash->memoria - bytes_anteriores + presupuesto_bytes(hash, largo, dato);
+		presupuesto_ajustar(hash, clave, largo, h);
+	}
+
+	return true;
+}
+
+/* ******************************************************************
+ *            FUNCIONES AUXILIARES DE LA CONSTRUCCION EN PARALELO
+ * *****************************************************************/
+
+// Devuelve la partición (de 0 a hilos - 1) a la que pertenece el hash h.
+static size_t construccion_particion(const construccion_t* construccion, uint64_t h) {
+
+	size_t balde = h & (construccion->hash->tamanio - 1);
+
+	return balde * construccion->hilos / construccion->hash->tamanio;
+}
+
+// Devuelve el primer par de la porción que le toca al trabajo.
+static size_t construccion_inicio(const construccion_t* construccion, size_t numero) {
+
+	return numero * (construccion->n / construccion->hilos);
+}
+
+// Devuelve el par siguiente al último de la porción que le toca al trabajo.
+static size_t construccion_fin(const construccion_t* construccion, size_t numero) {
+
+	if (numero == construccion->hilos - 1) return construccion->n;
+
+	return construccion_inicio(construccion, numero + 1);
+}
+
+// Primera etapa: crea los nodos de la porción y cuenta cuántos caen en
+// cada partición.
+static void* construir_nodos(void* extra) {
+
+	trabajo_t* trabajo = extra;
+	construccion_t* construccion = trabajo->construccion;
+	size_t* cuentas = &construccion->desplazamientos[trabajo->numero * construccion->hilos];
+
+	trabajo->exito = true;
+
+	for (size_t i = construccion_inicio(construccion, trabajo->numero); i < construccion_fin(construccion, trabajo->numero); i++) {
+
+		const hash_par_t* par = &construccion->pares[i];
+		size_t largo = strlen(par->clave);
+		clave_valor_t* nodo = hash_crear_nodo(construccion->hash, par->clave, largo, hash_calcular(construccion->hash, par->clave, largo), par->dato);
+
+		if (!nodo) {
+			trabajo->exito = false;
+			return NULL;
+		}
+
+		construccion->nodos[i] = nodo;
+		(cuentas[construccion_particion(construccion, nodo->hash)])++;
+	}
+
+	return NULL;
+}
+
+// Segunda etapa: copia los nodos de la porción en el lugar de su
+// partición, sin alterar el orden en que venían los pares.
+static void* construir_agrupar(void* extra) {
+
+	trabajo_t* trabajo = extra;
+	construccion_t* construccion = trabajo->construccion;
+	size_t* desplazamientos = &construccion->desplazamientos[trabajo->numero * construccion->hilos];
+
+	for (size_t i = construccion_inicio(construccion, trabajo->numero); i < construccion_fin(construccion, trabajo->numero); i++) {
+
+		clave_valor_t* nodo = construccion->nodos[i];
+		size_t particion = construccion_particion(construccion, nodo->hash);
+
+		construccion->agrupados[(desplazamientos[particion])++] = nodo;
+	}
+
+	return NULL;
+}
+
+// Tercera etapa: engancha los nodos de una partición al final de sus
+// baldes. Si una clave se repite, queda el valor del último par, como si
+// se hubieran guardado uno por uno.
+static void* construir_enlazar(void* extra) {
+
+	trabajo_t* trabajo = extra;
+	construccion_t* construccion = trabajo->construccion;
+	hash_t* hash = construccion->hash;
+
+	trabajo->guardados = 0;
+
+	for (size_t i = construccion->inicio_particion[trabajo->numero]; i < construccion->inicio_particion[trabajo->numero + 1]; i++) {
+
+		clave_valor_t* nodo = construccion->agrupados[i];
+		clave_valor_t* *lugar = &hash->datos[nodo->hash & (hash->tamanio - 1)];
+
+		while (*lugar && !((*lugar)->hash == nodo->hash && (*lugar)->largo == nodo->largo &&
+			memcmp((*lugar)->clave, nodo->clave, nodo->largo) == 0))
+			lugar = &(*lugar)->siguiente;
+
+		if (*lugar) {
+
+			if (hash->destruir_dato) hash->destruir_dato((*lugar)->valor);
+
+			(*lugar)->valor = hash_destuir_nodo(nodo);
+			continue;
+		}
+
+		nodo->siguiente = NULL;
+		*lugar = nodo;
+		(trabajo->guardados)++;
+	}
+
+	return NULL;
+}
+
+// Ejecuta la etapa para cada trabajo, cada uno en su propio hilo. Si no se
+// puede crear un hilo, ese trabajo se ejecuta en el hilo actual.
+static void construccion_ejecutar(trabajo_t* trabajos, size_t cantidad, void* (*etapa)(void*)) {
+
+	for (size_t i = 1; i < cantidad; i++)
+		trabajos[i].creado = (pthread_create(&trabajos[i].hilo, NULL, etapa, &trabajos[i]) == 0);
+
+	etapa(&trabajos[0]);
+
+	for (size_t i = 1; i < cantidad; i++) {
+
+		if (trabajos[i].creado) pthread_join(trabajos[i].hilo, NULL);
+		else etapa(&trabajos[i]);
+	}
+}
+
+// Calcula dónde empieza cada partición en el arreglo de agrupados y, en
+// desplazamientos, dónde copia cada trabajo sus nodos de cada partición.
+static void construccion_calcular_desplazamientos(construccion_t* construccion) {
+
+	size_t hilos = construccion->hilos;
+	size_t acumulado = 0;
+
+	for (size_t particion = 0; particion < hilos; particion++) {
+
+		construccion->inicio_particion[particion] = acumulado;
+
+		for (size_t numero = 0; numero < hilos; numero++) {
+
+			size_t* desplazamiento = &construccion->desplazamientos[numero * hilos + particion];
+			size_t cuenta = *desplazamiento;
+
+			*desplazamiento = acumulado;
+			acumulado += cuenta;
+		}
+	}
+
+	construccion->inicio_particion[hilos] = acumulado;
+}
+
+/* ******************************************************************
+ *               FUNCIONES AUXILIARES DE LAS ESTADISTICAS
+ * *****************************************************************/
+
+// Agrega al histograma un balde o elemento de largo 'largo'.
+static void estadisticas_anotar(hash_estadisticas_t* estadisticas, size_t largo) {
+
+	size_t casillero = (largo < HASH_LARGO_HISTOGRAMA) ? largo : HASH_LARGO_HISTOGRAMA - 1;
+
+	(estadisticas->histograma[casillero])++;
+
+	if (largo > estadisticas->largo_maximo) estadisticas->largo_maximo = largo;
+}
+
+// Devuelve la cantidad de grupos que recorre la búsqueda del nodo guardado
+// en la ranura pos de la tabla abierta.
+static size_t abierto_largo_sondeo(const hash_t* hash, size_t pos) {
+
+	size_t cant_grupos = hash->tamanio / TAM_GRUPO;
+	size_t grupo = (abierto_ranura(hash, pos)->hash >> 7) & (cant_grupos - 1);
+	size_t largo = 1;
+
+	while (grupo != pos / TAM_GRUPO) {
+
+		grupo = (grupo + largo) & (cant_grupos - 1);
+		largo++;
+	}
+
+	return largo;
+}
+
+static void estadisticas_encadenado(const hash_t* hash, hash_estadisticas_t* estadisticas) {
+
+	estadisticas->baldes = hash_cantidad_baldes(hash);
+	estadisticas->bytes += estadisticas->baldes * sizeof(clave_valor_t*);
+
+	for (size_t i = 0; i < hash_cantidad_baldes(hash); i++) {
+
+		size_t largo = 0;
+
+		for (clave_valor_t* nodo = hash_balde_en(hash, i); nodo; nodo = nodo->siguiente) {
+
+			estadisticas->bytes += sizeof(clave_valor_t) + nodo->largo + 1;
+			largo++;
+		}
+
+		if (largo > 0) (estadisticas->baldes_ocupados)++;
+
+		estadisticas_anotar(estadisticas, largo);
+	}
+
+	if (estadisticas->baldes_ocupados > 0)
+		estadisticas->largo_promedio = (double) hash->cantidad_elementos / estadisticas->baldes_ocupados;
+}
+
+static void estadisticas_abierto(const hash_t* hash, hash_estadisticas_t* estadisticas) {
+
+	size_t largo_total = 0;
+
+	estadisticas->baldes = hash->tamanio;
+	estadisticas->baldes_ocupados = hash->cantidad_elementos;
+	estadisticas->bytes += hash->tamanio * (sizeof(uint8_t) + TAM_RANURA);
+
+	for (size_t i = abierto_proxima_ranura(hash, 0); i < hash->tamanio; i = abierto_proxima_ranura(hash, i + 1)) {
+
+		size_t largo = abierto_largo_sondeo(hash, i);
+		size_t largo_clave = abierto_ranura(hash, i)->largo;
+
+		if (!abierto_clave_corta(largo_clave)) estadisticas->bytes += sizeof(clave_valor_t) + largo_clave + 1;
+		largo_total += largo;
+
+		estadisticas_anotar(estadisticas, largo);
+	}
+
+	if (hash->cantidad_elementos > 0)
+		estadisticas->largo_promedio = (double) largo_total / hash->cantidad_elementos;
+}
+
+static void estadisticas_ordenado(const hash_t* hash, hash_estadisticas_t* estadisticas) {
+
+	size_t mascara = hash->tamanio - 1;
+	size_t largo_total = 0;
+
+	estadisticas->baldes = hash->tamanio;
+	estadisticas->baldes_ocupados = hash->cantidad_elementos;
+	estadisticas->bytes += hash->tamanio * sizeof(size_t) + ordenado_capacidad(hash->tamanio) * sizeof(clave_valor_t*);
+
+	for (size_t i = 0; i < hash->tamanio; i++) {
+
+		if (hash->indice[i] == INDICE_VACIO || hash->indice[i] == INDICE_BORRADO) continue;
+
+		const clave_valor_t* nodo = hash->entradas[hash->indice[i]];
+		size_t largo = ((i - nodo->hash) & mascara) + 1;
+
+		estadisticas->bytes += sizeof(clave_valor_t) + nodo->largo + 1;
+		largo_total += largo;
+
+		estadisticas_anotar(estadisticas, largo);
+	}
+
+	if (hash->cantidad_elementos > 0)
+		estadisticas->largo_promedio = (double) largo_total / hash->cantidad_elementos;
+}
+
+static void estadisticas_mapeado(const hash_t* hash, hash_estadisticas_t* estadisticas) {
+
+	size_t mascara = hash->tamanio - 1;
+	size_t largo_total = 0;
+
+	estadisticas->baldes = hash->tamanio;
+	estadisticas->baldes_ocupados = hash->cantidad_elementos;
+	estadisticas->bytes += hash->largo_imagen;
+
+	for (size_t i = mapeado_proxima_ranura(hash, 0); i < hash->tamanio; i = mapeado_proxima_ranura(hash, i + 1)) {
+
+		size_t largo = ((i - mapeado_ranura(hash, i)->hash) & mascara) + 1;
+
+		largo_total += largo;
+
+		estadisticas_anotar(estadisticas, largo);
+	}
+
+	if (hash->cantidad_elementos > 0)
+		estadisticas->largo_promedio = (double) largo_total / hash->cantidad_elementos;
+}
+
+/* ******************************************************************
+ *                    FUNCIONES DE HASH
+ * *****************************************************************/
+
+uint64_t hash_fnv1a(const char *clave, size_t largo) {
+
+	uint64_t h = FNV_BASE;
+	size_t i = 0;
+
+	for (; i + sizeof(uint64_t) <= largo; i += sizeof(uint64_t))
+		h = (h ^ leer64(clave + i)) * FNV_PRIMO;
+
+	for (; i < largo; i++)
+		h = (h ^ (unsigned char) clave[i]) * FNV_PRIMO;
+
+	// La multiplicación sólo lleva cada bit hacia los más altos: sin estos
+	// pliegues, los bits bajos dependerían sólo del principio de cada palabra.
+	h ^= h >> 32;
+
+	return h ^ (h >> 16);
+}
+
+uint64_t hash_wyhash(const char *clave, size_t largo) {
+
+	const char* p = clave;
+	uint64_t semilla = wy_mezclar(WY_P0, WY_P1);
+	uint64_t a, b;
+
+	if (largo <= 16) {
+
+		// Las claves cortas se leen con a lo sumo cuatro lecturas, que
+		// pueden solaparse, sin recorrerlas byte a byte.
+		if (largo >= 4) {
+
+			size_t medio = (largo >> 3) << 2;
+
+			a = (leer32(p) << 32) | leer32(p + medio);
+			b = (leer32(p + largo - 4) << 32) | leer32(p + largo - 4 - medio);
+
+		} else if (largo > 0) {
+
+			a = ((uint64_t) (unsigned char) p[0] << 16) | ((uint64_t) (unsigned char) p[largo >> 1] << 8) | (unsigned char) p[largo - 1];
+			b = 0;
+
+		} else {
+			a = b = 0;
+		}
+
+	} else {
+
+		size_t resto = largo;
+
+		for (; resto > 16; resto -= 16, p += 16)
+			semilla = wy_mezclar(leer64(p) ^ WY_P1, leer64(p + 8) ^ semilla);
+
+		a = leer64(p + resto - 16);
+		b = leer64(p + resto - 8);
+	}
+
+	return wy_mezclar(WY_P1 ^ largo, wy_mezclar(a ^ WY_P1, b ^ semilla));
+}
+
+uint64_t hash_crc32c(const char *clave, size_t largo) {
+
+#ifndef __SSE4_2__
+	pthread_once(&crc32c_inicializada, crc32c_inicializar);
+#endif
+
+	// Dos CRC independientes, uno sobre las palabras pares y otro sobre las
+	// impares, se calculan a la vez y forman los 64 bits del resultado.
+	uint32_t pares = UINT32_MAX;
+	uint32_t impares = UINT32_MAX ^ (uint32_t) largo;
+	size_t i = 0;
+
+	for (; i + 2 * sizeof(uint64_t) <= largo; i += 2 * sizeof(uint64_t)) {
+		pares = crc32c_palabra(pares, clave + i);
+		impares = crc32c_palabra(impares, clave + i + sizeof(uint64_t));
+	}
+
+	if (i + sizeof(uint64_t) <= largo) {
+		pares = crc32c_palabra(pares, clave + i);
+		i += sizeof(uint64_t);
+	}
+
+	for (; i < largo; i++)
+		impares = crc32c_byte(impares, (unsigned char) clave[i]);
+
+	// Los bits bajos combinan ambas cadenas, que pueden no haber recorrido
+	// lo mismo (las claves de menos de 8 bytes sólo pasan por la impar), y
+	// el segundo pliegue les suma los bits altos de cada una.
+	uint64_t h = ((uint64_t) ~impares << 32) | (uint32_t) ~pares;
+
+	h ^= h >> 32;
+
+	return h ^ (h >> 16);
+}
+
+/* ******************************************************************
+ *                    PRIMITIVAS DEL HASH
+ * ******************************************************************/
+
+hash_t* hash_crear_con_capacidad(hash_destruir_dato_t destruir_dato, f_hash_t fhash, size_t capacidad) {
+
+	hash_t* hash = malloc(sizeof(hash_t));
+	if (!hash) return NULL;
+
+	hash->factor_min = MIN_FACTOR_DE_CARGA;
+	hash->factor_max = MAX_FACTOR_DE_CARGA;
+	hash->tamanio = encadenado_tamanio_para(hash, capacidad);
+	hash->datos = calloc(hash->tamanio, sizeof(clave_valor_t*));
+
+	if (!hash->datos) {
+		free(hash);
+		return NULL;
+	}
+
+	hash->cantidad_elementos = 0;
+	hash->tamanio_minimo = hash->tamanio;
+	hash->destruir_dato = destruir_dato;
+	hash->fhash = fhash;
+	hash->datos_viejos = NULL;
+	hash->tamanio_viejo = 0;
+	hash->migrados = 0;
+	hash->tipo = HASH_ENCADENADO;
+	hash->control = NULL;
+	hash->ranuras = NULL;
+	hash->borrados = 0;
+	hash->imagen = NULL;
+	hash->entradas = NULL;
+	hash->indice = NULL;
+	hash->usadas = 0;
+	hash->filtro = NULL;
+	hash->bits_filtro = 0;
+	hash->presupuesto = 0;
+	hash->memoria = 0;
+	hash->tamanio_dato = NULL;
+	hash->politica = HASH_DESALOJO_RELOJ;
+	hash->marca = 0;
+	hash->aguja = 0;
+	hash->azar = SEMILLA_DESALOJO;
+	hash->largo_imagen = 0;
+	hash_inicializar_contadores(hash);
+
+	return hash;
+}
+
+hash_t* hash_crear(hash_destruir_dato_t destruir_dato, f_hash_t fhash) {
+
+	return hash_crear_con_capacidad(destruir_dato, fhash, 0);
+}
+
+hash_t* hash_crear_default(hash_destruir_dato_t destruir_dato) {
+
+	return hash_crear(destruir_dato, hash_wyhash);
+}
+
+hash_t* hash_crear_con_tipo(hash_destruir_dato_t destruir_dato, f_hash_t fhash, hash_tipo_t tipo) {
+
+	if (tipo == HASH_ENCADENADO) return hash_crear(destruir_dato, fhash);
+
+	if (tipo != HASH_ABIERTO && tipo != HASH_ORDENADO) return NULL;
+
+	hash_t* hash = malloc(sizeof(hash_t));
+	if (!hash) return NULL;
+
+	hash->datos = NULL;
+	hash->cantidad_elementos = 0;
+	hash->factor_min = MIN_FACTOR_DE_CARGA;
+	hash->factor_max = MAX_FACTOR_DE_CARGA;
+	hash->destruir_dato = destruir_dato;
+	hash->fhash = fhash;
+	hash->datos_viejos = NULL;
+	hash->tamanio_viejo = 0;
+	hash->migrados = 0;
+	hash->tipo = tipo;
+	hash->control = NULL;
+	hash->ranuras = NULL;
+	hash->borrados = 0;
+	hash->imagen = NULL;
+	hash->largo_imagen = 0;
+	hash->entradas = NULL;
+	hash->indice = NULL;
+	hash->usadas = 0;
+	hash->filtro = NULL;
+	hash->bits_filtro = 0;
+	hash->presupuesto = 0;
+	hash->memoria = 0;
+	hash->tamanio_dato = NULL;
+	hash->politica = HASH_DESALOJO_RELOJ;
+	hash->marca = 0;
+	hash->aguja = 0;
+	hash->azar = SEMILLA_DESALOJO;
+
+	bool inicializada;
+
+	if (tipo == HASH_ABIERTO) {
+		hash->tamanio_minimo = TAM_INICIAL_ABIERTO;
+		inicializada = abierto_inicializar(hash, TAM_INICIAL_ABIERTO);
+	} else {
+		hash->tamanio_minimo = TAM_INICIAL_ORDENADO;
+		inicializada = ordenado_redimensionar(hash, TAM_INICIAL_ORDENADO);
+	}
+
+	if (!inicializada) {
+		free(hash);
+		return NULL;
+	}
+
+	hash_inicializar_contadores(hash);
+
+	return hash;
+}
+
+hash_t* hash_construir(const hash_par_t pares[], size_t n, hash_destruir_dato_t destruir_dato, f_hash_t fhash, size_t hilos) {
+
+	hash_t* hash = hash_crear_con_capacidad(destruir_dato, fhash, n);
+
+	if (!hash || n == 0) return hash;
+
+	// Cada partición tiene que tener al menos un balde.
+	if (hilos > n / MIN_PARES_POR_HILO) hilos = n / MIN_PARES_POR_HILO;
+	if (hilos > hash->tamanio) hilos = hash->tamanio;
+	if (hilos == 0) hilos = 1;
+
+	construccion_t construccion = { pares, n, hilos, hash };
+
+	construccion.nodos = calloc(n, sizeof(clave_valor_t*));
+	construccion.agrupados = malloc(sizeof(clave_valor_t*) * n);
+	construccion.desplazamientos = calloc(hilos * hilos, sizeof(size_t));
+	construccion.inicio_particion = malloc(sizeof(size_t) * (hilos + 1));
+
+	trabajo_t* trabajos = malloc(sizeof(trabajo_t) * hilos);
+	bool exito = trabajos && construccion.nodos && construccion.agrupados &&
+		construccion.desplazamientos && construccion.inicio_particion;
+
+	for (size_t i = 0; exito && i < hilos; i++) {
+		trabajos[i].construccion = &construccion;
+		trabajos[i].numero = i;
+	}
+
+	if (exito) {
+
+		construccion_ejecutar(trabajos, hilos, construir_nodos);
+
+		for (size_t i = 0; i < hilos; i++)
+			exito = exito && trabajos[i].exito;
+	}
+
+	if (exito) {
+
+		construccion_calcular_desplazamientos(&construccion);
+		construccion_ejecutar(trabajos, hilos, construir_agrupar);
+		construccion_ejecutar(trabajos, hilos, construir_enlazar);
+
+		for (size_t i = 0; i < hilos; i++)
+			hash->cantidad_elementos += trabajos[i].guardados;
+
+	} else if (construccion.nodos) {
+
+		// Los datos siguen perteneciendo al llamador: sólo se liberan los nodos.
+		for (size_t i = 0; i < n; i++)
+			free(construccion.nodos[i]);
+	}
+
+	free(trabajos);
+	free(construccion.nodos);
+	free(construccion.agrupados);
+	free(construccion.desplazamientos);
+	free(construccion.inicio_particion);
+
+	if (!exito) {
+		free(hash->datos);
+		free(hash);
+		return NULL;
+	}
+
+	return hash;
+}
+
+bool hash_guardar(hash_t *hash, const char *clave, void *dato) {
+
+	size_t largo = strlen(clave);
+
+	return hash_guardar_calculado(hash, clave, largo, hash_calcular(hash, clave, largo), dato);
+}
+
+bool hash_guardar_lote(hash_t *hash, const char* const claves[], void* const datos[], size_t n) {
+
+	size_t largos[TAM_LOTE];
+	uint64_t hashes[TAM_LOTE];
+
+	for (size_t inicio = 0; inicio < n; inicio += TAM_LOTE) {
+
+		size_t cant = (n - inicio < TAM_LOTE) ? n - inicio : TAM_LOTE;
+
+		for (size_t i = 0; i < cant; i++) {
+
+			largos[i] = strlen(claves[inicio + i]);
+			hashes[i] = hash_calcular(hash, claves[inicio + i], largos[i]);
+			hash_precargar_balde(hash, hashes[i]);
+		}
+
+		for (size_t i = 0; i < cant; i++) {
+
+			if (!hash_guardar_calculado(hash, claves[inicio + i], largos[i], hashes[i], datos[inicio + i]))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+void* hash_borrar_dato(hash_t *hash, const char *clave) {
+
+	size_t largo = strlen(clave);
+
+	return hash_borrar_calculado(hash, clave, largo, hash_calcular(hash, clave, largo));
+}
+
+bool hash_borrar(hash_t *hash, const char *clave) {
+
+	return (hash_borrar_dato(hash, clave) != NULL);
+}
+
+void* hash_obtener(const hash_t *hash, const char *clave) {
+
+	if (hash_esta_vacio(hash)) return NULL;
+
+	size_t largo = strlen(clave);
+	void* valor;
+
+	hash_obtener_calculado(hash, clave, largo, hash_calcular(hash, clave, largo), &valor);
+
+	return valor;
+}
+
+void hash_obtener_lote(const hash_t *hash, const char* const claves[], size_t n, void* resultados[]) {
+
+	size_t largos[TAM_LOTE];
+	uint64_t hashes[TAM_LOTE];
+
+	for (size_t inicio = 0; inicio < n; inicio += TAM_LOTE) {
+
+		size_t cant = (n - inicio < TAM_LOTE) ? n - inicio : TAM_LOTE;
+
+		for (size_t i = 0; i < cant; i++) {
+
+			largos[i] = strlen(claves[inicio + i]);
+			hashes[i] = hash_calcular(hash, claves[inicio + i], largos[i]);
+			hash_precargar_balde(hash, hashes[i]);
+		}
+
+		for (size_t i = 0; i < cant; i++)
+			hash_precargar_nodo(hash, hashes[i]);
+
+		for (size_t i = 0; i < cant; i++) {
+
+			hash_obtener_calculado(hash, claves[inicio + i], largos[i], hashes[i], &resultados[inicio + i]);
+		}
+	}
+}
+
+bool hash_pertenece(const hash_t *hash, const char *clave) {
+
+	if (hash_esta_vacio(hash)) return false;
+
+	size_t largo = strlen(clave);
+	void* valor;
+
+	return hash_obtener_calculado(hash, clave, largo, hash_calcular(hash, clave, largo), &valor);
+}
+
+bool hash_guardar_bin(hash_t *hash, const void *clave, size_t largo, void *dato) {
+
+	return hash_guardar_calculado(hash, clave, largo, hash_calcular(hash, clave, largo), dato);
+}
+
+void* hash_borrar_dato_bin(hash_t *hash, const void *clave, size_t largo) {
+
+	return hash_borrar_calculado(hash, clave, largo, hash_calcular(hash, clave, largo));
+}
+
+void* hash_obtener_bin(const hash_t *hash, const void *clave, size_t largo) {
+
+	void* valor = NULL;
+
+	if (!hash_esta_vacio(hash))
+		hash_obtener_calculado(hash, clave, largo, hash_calcular(hash, clave, largo), &valor);
+
+	return valor;
+}
+
+bool hash_pertenece_bin(const hash_t *hash, const void *clave, size_t largo) {
+
+	void* valor;
+
+	if (hash_esta_vacio(hash)) return false;
+
+	return hash_obtener_calculado(hash, clave, largo, hash_calcular(hash, clave, largo), &valor);
+}
+
+uint64_t hash_calcular_bin(const hash_t *hash, const void *clave, size_t largo) {
+
+	return hash_calcular(hash, clave, largo);
+}
+
+bool hash_guardar_con_hash(hash_t *hash, const void *clave, size_t largo, uint64_t h, void *dato) {
+
+	return hash_guardar_calculado(hash, clave, largo, h, dato);
+}
+
+void* hash_borrar_dato_con_hash(hash_t *hash, const void *clave, size_t largo, uint64_t h) {
+
+	return hash_borrar_calculado(hash, clave, largo, h);
+}
+
+void* hash_obtener_con_hash(const hash_t *hash, const void *clave, size_t largo, uint64_t h) {
+
+	void* valor = NULL;
+
+	if (!hash_esta_vacio(hash))
+		hash_obtener_calculado(hash, clave, largo, h, &valor);
+
+	return valor;
+}
+
+bool hash_pertenece_con_hash(const hash_t *hash, const void *clave, size_t largo, uint64_t h) {
+
+	void* valor;
+
+	if (hash_esta_vacio(hash)) return false;
+
+	return hash_obtener_calculado(hash, clave, largo, h, &valor);
+}
+
+const char* hash_obtener_clave_con_hash(const hash_t *hash, const void *clave, size_t largo, uint64_t h) {
+
+	if (hash_esta_vacio(hash)) return NULL;
+
+	if (hash->tipo == HASH_MAPEADO) {
+
+		const imagen_entrada_t* entrada = mapeado_buscar(hash, clave, largo, h);
+
+		return entrada ? entrada->clave : NULL;
+	}
+
+	clave_valor_t* nodo = hash_nodo_calculado(hash, clave, largo, h);
+
+	return nodo ? nodo->clave : NULL;
+}
+
+size_t hash_cantidad(const hash_t *hash) {
+
+	return hash->cantidad_elementos;
+}
+
+bool hash_reservar(hash_t *hash, size_t cantidad) {
+
+	if (hash->tipo == HASH_MAPEADO) return false;
+
+	if (hash->tipo == HASH_ORDENADO) {
+
+		size_t necesario = ordenado_tamanio_para(cantidad);
+
+		if (necesario > hash->tamanio && !ordenado_redimensionar(hash, necesario)) return false;
+
+		if (necesario > hash->tamanio_minimo) hash->tamanio_minimo = necesario;
+
+		return true;
+	}
+
+	if (hash->tipo == HASH_ABIERTO) {
+
+		size_t necesario = abierto_tamanio_para(cantidad);
+
+		if (necesario > hash->tamanio && !abierto_redimensionar(hash, necesario)) return false;
+
+		if (necesario > hash->tamanio_minimo) hash->tamanio_minimo = necesario;
+
+		return true;
+	}
+
+	size_t necesario = encadenado_tamanio_para(hash, cantidad);
+
+	if (necesario > hash->tamanio && !hash_redimensionar(hash, necesario)) return false;
+
+	if (necesario > hash->tamanio_minimo) hash->tamanio_minimo = necesario;
+
+	return true;
+}
+
+bool hash_compactar(hash_t *hash) {
+
+	if (hash->tipo == HASH_MAPEADO) return true;
+
+	if (hash->filtro) filtro_reconstruir(hash, hash->bits_filtro);
+
+	if (hash->tipo == HASH_ABIERTO) {
+
+		hash->tamanio_minimo = TAM_INICIAL_ABIERTO;
+
+		return abierto_redimensionar(hash, abierto_tamanio_para(hash->cantidad_elementos));
+	}
+
+	if (hash->tipo == HASH_ORDENADO) {
+
+		hash->tamanio_minimo = TAM_INICIAL_ORDENADO;
+
+		return ordenado_redimensionar(hash, ordenado_tamanio_para(hash->cantidad_elementos));
+	}
+
+	hash->tamanio_minimo = TAM_INICIAL;
+
+	size_t necesario = encadenado_tamanio_para(hash, hash->cantidad_elementos);
+
+	hash_migrar(hash, hash->tamanio_viejo);
+
+	if (necesario == hash->tamanio) return true;
+
+	if (!hash_redimensionar(hash, necesario)) return false;
+
+	hash_migrar(hash, hash->tamanio_viejo);
+
+	return true;
+}
+
+bool hash_agregar_filtro(hash_t *hash, size_t bits_por_clave) {
+
+	if (hash->tipo == HASH_MAPEADO || bits_por_clave == 0) return false;
+
+	return filtro_reconstruir(hash, bits_por_clave);
+}
+
+void hash_quitar_filtro(hash_t *hash) {
+
+	if (hash->filtro) bloom_destruir(hash->filtro);
+
+	hash->filtro = NULL;
+	hash->bits_filtro = 0;
+}
+
+bool hash_limitar_memoria(hash_t *hash, size_t presupuesto, hash_tamanio_dato_t tamanio_dato, hash_politica_t politica) {
+
+	if (hash->tipo == HASH_MAPEADO) return false;
+
+	if (politica != HASH_DESALOJO_RELOJ && politica != HASH_DESALOJO_LRU_MUESTREADO && politica != HASH_DESALOJO_ALEATORIO)
+		return false;
+
+	// La marca de CLOCK es siempre 1 (usada) y la del LRU, un reloj. Sin
+	// presupuesto o con desalojo al azar no se usan, y queda en 0 para
+	// que las búsquedas no escriban los nodos.
+	hash->presupuesto = presupuesto;
+	hash->tamanio_dato = presupuesto ? tamanio_dato : NULL;
+	hash->politica = politica;
+	hash->marca = (presupuesto && politica != HASH_DESALOJO_ALEATORIO) ? 1 : 0;
+	hash->aguja = 0;
+	hash->memoria = 0;
+
+	if (!presupuesto) return true;
+
+	hash_iterar_entradas(hash, sumar_bytes, hash);
+	presupuesto_ajustar(hash, NULL, 0, 0);
+
+	return true;
+}
+
+size_t hash_memoria(const hash_t *hash) {
+
+	return hash->memoria;
+}
+
+bool hash_configurar_factores(hash_t *hash, float factor_min, float factor_max) {
+
+	if (factor_min < 0 || factor_max <= 0) return false;
+
+	// Después de crecer o achicarse, la tabla tiene que quedar entre ambos factores.
+	if (factor_min * 2 * FACTOR_MULTIPLICACION > factor_max) return false;
+
+	hash->factor_min = factor_min;
+	hash->factor_max = factor_max;
+
+	return true;
+}
+
+void hash_estadisticas(const hash_t *hash, hash_estadisticas_t *estadisticas) {
+
+	memset(estadisticas, 0, sizeof(hash_estadisticas_t));
+
+	estadisticas->tipo = hash->tipo;
+	estadisticas->cantidad = hash->cantidad_elementos;
+	estadisticas->redimensiones = hash->redimensiones;
+	estadisticas->desalojos = hash->desalojos;
+	estadisticas->bytes = sizeof(hash_t);
+
+	if (hash->tipo == HASH_MAPEADO) estadisticas_mapeado(hash, estadisticas);
+	else if (hash->tipo == HASH_ABIERTO) estadisticas_abierto(hash, estadisticas);
+	else if (hash->tipo == HASH_ORDENADO) estadisticas_ordenado(hash, estadisticas);
+	else estadisticas_encadenado(hash, estadisticas);
+
+#ifdef HASH_ESTADISTICAS
+	estadisticas->busquedas = hash->busquedas;
+
+	if (hash->busquedas > 0) {
+		estadisticas->sondeos_por_busqueda = (double) hash->sondeos / hash->busquedas;
+		estadisticas->comparaciones_por_busqueda = (double) hash->comparaciones / hash->busquedas;
+	}
+#endif
+}
+
+void hash_iterar(const hash_t *hash, bool (*visitar)(const char *clave, void *dato, void *extra), void *extra) {
+
+	visitante_t visitante = { visitar, extra };
+
+	hash_iterar_entradas(hash, visitar_sin_largo, &visitante);
+}
+
+lista_t* hash_claves(const hash_t* hash) {
+
+	lista_t* lista = lista_crear();
+
+	if (!lista) return NULL;
+
+	hash_iterar(hash, agregar_clave_a_lista, lista);
+
+	return lista;
+}
+
+size_t hash_claves_arreglo(const hash_t* hash, const char* claves[], size_t tam) {
+
+	arreglo_claves_t arreglo = { claves, tam, 0 };
+
+	if (tam > 0) hash_iterar(hash, agregar_clave_a_arreglo, &arreglo);
+
+	return arreglo.cantidad;
+}
+
+bool hash_serializar(const hash_t *hash, int fd, hash_serializar_dato_t serializar_dato) {
+
+	serializacion_t serializacion = { NULL, 0, serializar_dato };
+	size_t tamanio = TAM_INICIAL_IMAGEN;
+
+	while (tamanio < 2 * hash->cantidad_elementos)
+		tamanio *= 2;
+
+	serializacion.elementos = malloc(sizeof(elemento_serializado_t) * (hash->cantidad_elementos + 1));
+	imagen_ranura_t* ranuras = calloc(tamanio, sizeof(imagen_ranura_t));
+	escritor_t* escritor = malloc(sizeof(escritor_t));
+
+	if (!serializacion.elementos || !ranuras || !escritor) {
+		free(serializacion.elementos);
+		free(ranuras);
+		free(escritor);
+		return false;
+	}
+
+	hash_iterar_entradas(hash, agregar_a_serializacion, &serializacion);
+
+	// La imagen se indexa siempre con la función por defecto, para que
+	// hash_mapear no necesite saber con qué función se creó la tabla.
+	uint64_t desplazamiento = sizeof(imagen_encabezado_t) + tamanio * sizeof(imagen_ranura_t);
+
+	for (size_t i = 0; i < serializacion.cantidad; i++) {
+
+		elemento_serializado_t* elemento = &serializacion.elementos[i];
+		uint64_t h = mezclar(fhash(elemento->clave, elemento->largo_clave));
+		size_t pos = h & (tamanio - 1);
+
+		while (ranuras[pos].desplazamiento != 0)
+			pos = (pos + 1) & (tamanio - 1);
+
+		ranuras[pos].hash = h;
+		ranuras[pos].desplazamiento = desplazamiento;
+
+		desplazamiento += sizeof(imagen_entrada_t) + alinear(elemento->largo_clave + 1);
+		desplazamiento += alinear(elemento->largo_valor);
+	}
+
+	imagen_encabezado_t encabezado;
+	memcpy(encabezado.firma, FIRMA_IMAGEN, sizeof(encabezado.firma));
+	encabezado.cantidad = serializacion.cantidad;
+	encabezado.tamanio = tamanio;
+	encabezado.largo = desplazamiento;
+
+	escritor->fd = fd;
+	escritor->usados = 0;
+
+	bool salida = escritor_escribir(escritor, &encabezado, sizeof(encabezado)) &&
+		escritor_escribir(escritor, ranuras, tamanio * sizeof(imagen_ranura_t));
+
+	for (size_t i = 0; salida && i < serializacion.cantidad; i++) {
+
+		elemento_serializado_t* elemento = &serializacion.elementos[i];
+		imagen_entrada_t entrada = { elemento->largo_clave, elemento->largo_valor };
+
+		salida = escritor_escribir(escritor, &entrada, sizeof(entrada)) &&
+			escritor_escribir(escritor, elemento->clave, elemento->largo_clave + 1) &&
+			escritor_rellenar(escritor, elemento->largo_clave + 1) &&
+			escritor_escribir(escritor, elemento->valor, elemento->largo_valor) &&
+			escritor_rellenar(escritor, elemento->largo_valor);
+	}
+
+	salida = salida && escritor_vaciar(escritor);
+
+	free(serializacion.elementos);
+	free(ranuras);
+	free(escritor);
+
+	return salida;
+}
+
+hash_t* hash_mapear(const char *ruta) {
+
+	int fd = open(ruta, O_RDONLY);
+
+	if (fd < 0) return NULL;
+
+	struct stat estado;
+	void* imagen = MAP_FAILED;
+
+	if (fstat(fd, &estado) == 0 && (size_t) estado.st_size >= sizeof(imagen_encabezado_t))
+		imagen = mmap(NULL, estado.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// El mapeo sigue siendo válido después de cerrar el archivo.
+	close(fd);
+
+	if (imagen == MAP_FAILED) return NULL;
+
+	const imagen_encabezado_t* encabezado = imagen;
+	uint64_t tamanio = encabezado->tamanio;
+
+	if (memcmp(encabezado->firma, FIRMA_IMAGEN, sizeof(encabezado->firma)) != 0 ||
+		encabezado->largo != (uint64_t) estado.st_size || (encabezado->largo & 7) != 0 ||
+		tamanio == 0 || (tamanio & (tamanio - 1)) != 0 || encabezado->cantidad >= tamanio ||
+		tamanio > (encabezado->largo - sizeof(imagen_encabezado_t)) / sizeof(imagen_ranura_t)) {
+
+		munmap(imagen, estado.st_size);
+		return NULL;
+	}
+
+	hash_t* hash = malloc(sizeof(hash_t));
+
+	if (!hash) {
+		munmap(imagen, estado.st_size);
+		return NULL;
+	}
+
+	hash->datos = NULL;
+	hash->cantidad_elementos = encabezado->cantidad;
+	hash->tamanio = tamanio;
+	hash->destruir_dato = NULL;
+	hash->fhash = fhash;
+	hash->datos_viejos = NULL;
+	hash->tamanio_viejo = 0;
+	hash->migrados = 0;
+	hash->factor_min = MIN_FACTOR_DE_CARGA;
+	hash->factor_max = MAX_FACTOR_DE_CARGA;
+	hash->tamanio_minimo = tamanio;
+	hash->tipo = HASH_MAPEADO;
+	hash->control = NULL;
+	hash->ranuras = NULL;
+	hash->borrados = 0;
+	hash->imagen = imagen;
+	hash->entradas = NULL;
+	hash->indice = NULL;
+	hash->usadas = 0;
+	hash->filtro = NULL;
+	hash->bits_filtro = 0;
+	hash->presupuesto = 0;
+	hash->memoria = 0;
+	hash->tamanio_dato = NULL;
+	hash->politica = HASH_DESALOJO_RELOJ;
+	hash->marca = 0;
+	hash->aguja = 0;
+	hash->azar = SEMILLA_DESALOJO;
+	hash->largo_imagen = estado.st_size;
+	hash_inicializar_contadores(hash);
+
+	return hash;
+}
+
+void hash_destruir(hash_t *hash) {
+
+	if (hash->filtro) bloom_destruir(hash->filtro);
+
+	if (hash->tipo == HASH_MAPEADO) {
+		munmap((void*) hash->imagen, hash->largo_imagen);
+		free(hash);
+		return;
+	}
+
+	if (hash->tipo == HASH_ABIERTO) {
+		hash_abierto_destruir(hash);
+		return;
+	}
+
+	if (hash->tipo == HASH_ORDENADO) {
+		hash_ordenado_destruir(hash);
+		return;
+	}
+
+	void* aux_valor;
+
+	hash_destruir_dato_t destruir_dato = hash->destruir_dato;
+
+	for (size_t i = 0; i < hash_cantidad_baldes(hash); i++) {
+
+		clave_valor_t* nodo = hash_balde_en(hash, i);
+
+		while (nodo) {
+
+			clave_valor_t* siguiente = nodo->siguiente;
+			aux_valor = hash_destuir_nodo(nodo);
+
+			if (destruir_dato) destruir_dato(aux_valor);
+
+			nodo = siguiente;
+		}
+	}
+
+	free(hash->datos_viejos);
+	free(hash->datos);
+	free(hash);
+}
+
+/* ******************************************************************
+ *                    PRIMITIVAS DEL ITERADOR
+ * *****************************************************************/
+
+hash_iter_t *hash_iter_crear(const hash_t *hash) {
+
+	size_t proximo_elemento;
+	hash_iter_t* iter_nuevo = malloc(sizeof(hash_iter_t));
+
+	if (!iter_nuevo) return NULL;
+
+	iter_nuevo->hash = hash;
+	iter_nuevo->actual = NULL;
+
+	if (hash->tipo == HASH_MAPEADO) {
+
+		iter_nuevo->posicion_actual = mapeado_proxima_ranura(hash, 0);
+		iter_nuevo->al_final = (iter_nuevo->posicion_actual == hash->tamanio);
+
+		return iter_nuevo;
+	}
+
+	if (hash->tipo == HASH_ABIERTO) {
+
+		iter_nuevo->posicion_actual = abierto_proxima_ranura(hash, 0);
+		iter_nuevo->al_final = (iter_nuevo->posicion_actual == hash->tamanio);
+
+		return iter_nuevo;
+	}
+
+	if (hash->tipo == HASH_ORDENADO) {
+
+		iter_nuevo->posicion_actual = ordenado_proxima_entrada(hash, 0);
+		iter_nuevo->al_final = (iter_nuevo->posicion_actual == hash->usadas);
+
+		return iter_nuevo;
+	}
+
+	iter_nuevo->posicion_actual = 0;
+	iter_nuevo->al_final = true;
+	proximo_elemento = hash_proximo_elemento(hash,-1);
+
+	if (proximo_elemento != hash_cantidad_baldes(hash)) {
+
+		iter_nuevo->posicion_actual = proximo_elemento;
+		iter_nuevo->al_final = false;
+		iter_nuevo->actual = hash_balde_en(hash, proximo_elemento);
+	}
+
+	return iter_nuevo;
+}
+
+bool hash_iter_avanzar(hash_iter_t *iter) {
+
+	if (iter->al_final) return false;
+
+	if (iter->hash->tipo == HASH_MAPEADO) {
+
+		iter->posicion_actual = mapeado_proxima_ranura(iter->hash, iter->posicion_actual + 1);
+		iter->al_final = (iter->posicion_actual == iter->hash->tamanio);
+
+		return !iter->al_final;
+	}
+
+	if (iter->hash->tipo == HASH_ABIERTO) {
+
+		iter->posicion_actual = abierto_proxima_ranura(iter->hash, iter->posicion_actual + 1);
+		iter->al_final = (iter->posicion_actual == iter->hash->tamanio);
+
+		return !iter->al_final;
+	}
+
+	if (iter->hash->tipo == HASH_ORDENADO) {
+
+		iter->posicion_actual = ordenado_proxima_entrada(iter->hash, iter->posicion_actual + 1);
+		iter->al_final = (iter->posicion_actual == iter->hash->usadas);
+
+		return !iter->al_final;
+	}
+
+	iter->actual = iter->actual->siguiente;
+
+	if (!iter->actual) {
+
+		size_t proximo_elemento = hash_proximo_elemento(iter->hash,iter->posicion_actual);
+
+		if (proximo_elemento == hash_cantidad_baldes(iter->hash)) {
+
+			iter->al_final = true;
+			return false;
+		}
+
+		iter->posicion_actual = proximo_elemento;
+		iter->actual = hash_balde_en(iter->hash, iter->posicion_actual);
 	}
 
 	return true;
@@ -425,13 +2989,16 @@ const char* hash_iter_ver_actual(const hash_iter_t *iter) {
 
 	if (iter->al_final) return NULL;
 
-	char* devolucion = NULL;
+	if (iter->hash->tipo == HASH_MAPEADO)
+		return mapeado_entrada(iter->hash, mapeado_ranura(iter->hash, iter->posicion_actual)->desplazamiento)->clave;
 
-	clave_valor_t* aux = lista_iter_ver_actual(iter->lista_iter);
+	if (iter->hash->tipo == HASH_ABIERTO)
+		return abierto_nodo(iter->hash, iter->posicion_actual)->clave;
 
-	if (aux != NULL) devolucion = aux->clave;
+	if (iter->hash->tipo == HASH_ORDENADO)
+		return iter->hash->entradas[iter->posicion_actual]->clave;
 
-	return devolucion;
+	return iter->actual->clave;
 }
 
 bool hash_iter_al_final(const hash_iter_t *iter) {
@@ -441,6 +3008,5 @@ bool hash_iter_al_final(const hash_iter_t *iter) {
 
 void hash_iter_destruir(hash_iter_t* iter) {
 
-	lista_iter_destruir(iter->lista_iter);
 	free(iter);
 }
@@ -0,0 +1,204 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define BITS_POR_PALABRA 64
+#define TAM_LINEA 64
+#define BITS_POR_BLOQUE (TAM_LINEA * 8)
+#define LOG_BITS_POR_BLOQUE 9
+#define PALABRAS_POR_BLOQUE (TAM_LINEA / sizeof(uint64_t))
+#define MAX_K 16
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+// Los bits de la clave se obtienen por doble hash: el i-ésimo es
+// h1 + i * h2, sobre todo el arreglo o, en la variante por bloques,
+// dentro del bloque elegido por la clave.
+typedef struct bloom {
+	uint64_t* bits;
+	void* reserva;
+	size_t cant_bits;
+	size_t cant_bloques;
+	size_t k;
+	bool por_bloques;
+	size_t cantidad;
+	size_t capacidad;
+} bloom_t;
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+// Finalizador de MurmurHash3: mezcla todos los bits de h.
+static uint64_t mezclar(uint64_t h) {
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+
+	return h;
+}
+
+// FNV-1a de 64 bits.
+static uint64_t hash_clave(const char* clave) {
+
+	uint64_t h = 0xcbf29ce484222325ULL;
+
+	for (const unsigned char* c = (const unsigned char*) clave; *c; c++) {
+		h ^= *c;
+		h *= 0x100000001b3ULL;
+	}
+
+	return h;
+}
+
+// Lleva x (de 32 bits) al rango [0, n) con una multiplicación en lugar de
+// una división.
+static size_t reducir(uint32_t x, size_t n) {
+
+	return (size_t) (((uint64_t) x * n) >> 32);
+}
+
+static bloom_t* crear(size_t capacidad, size_t bits_por_clave, size_t k, bool por_bloques) {
+
+	if (capacidad == 0) capacidad = 1;
+	if (bits_por_clave == 0) return NULL;
+
+	// k óptimo: bits_por_clave * ln 2, redondeado.
+	if (k == 0) k = (bits_por_clave * 693 + 500) / 1000;
+	if (k == 0) k = 1;
+	if (k > MAX_K) k = MAX_K;
+
+	size_t cant_bits = capacidad * bits_por_clave;
+
+	// Las posiciones de la variante común se calculan con 32 bits.
+	if (!por_bloques && cant_bits > UINT32_MAX) return NULL;
+
+	bloom_t* bloom = malloc(sizeof(bloom_t));
+
+	if (!bloom) return NULL;
+
+	size_t cant_bloques = (cant_bits + BITS_POR_BLOQUE - 1) / BITS_POR_BLOQUE;
+	size_t palabras = cant_bloques * PALABRAS_POR_BLOQUE;
+
+	// Se reserva una línea de más para alinear los bloques con las de la memoria.
+	bloom->reserva = calloc(palabras + PALABRAS_POR_BLOQUE, sizeof(uint64_t));
+
+	if (!bloom->reserva) {
+		free(bloom);
+		return NULL;
+	}
+
+	uintptr_t direccion = (uintptr_t) bloom->reserva;
+
+	bloom->bits = (uint64_t*) ((direccion + TAM_LINEA - 1) & ~(uintptr_t) (TAM_LINEA - 1));
+	bloom->cant_bits = por_bloques ? cant_bloques * BITS_POR_BLOQUE : cant_bits;
+	bloom->cant_bloques = cant_bloques;
+	bloom->k = k;
+	bloom->por_bloques = por_bloques;
+	bloom->cantidad = 0;
+	bloom->capacidad = capacidad;
+
+	return bloom;
+}
+
+// Devuelve el arreglo de bits sobre el que se ubican los bits de la clave:
+// todo el filtro o, en la variante por bloques, el bloque que le toca.
+static uint64_t* bits_de(const bloom_t* bloom, uint64_t h1) {
+
+	if (!bloom->por_bloques) return bloom->bits;
+
+	return bloom->bits + reducir((uint32_t) h1, bloom->cant_bloques) * PALABRAS_POR_BLOQUE;
+}
+
+// Devuelve la posición, dentro de bits_de, del bit que corresponde al
+// valor g (usa sus bits altos).
+static size_t bit_de(const bloom_t* bloom, uint64_t g) {
+
+	if (bloom->por_bloques) return (size_t) (g >> (64 - LOG_BITS_POR_BLOQUE));
+
+	return reducir((uint32_t) (g >> 32), bloom->cant_bits);
+}
+
+/* ******************************************************************
+ *                    PRIMITIVAS DEL FILTRO
+ * *****************************************************************/
+
+bloom_t* bloom_crear(size_t capacidad, size_t bits_por_clave, size_t k) {
+
+	return crear(capacidad, bits_por_clave, k, false);
+}
+
+bloom_t* bloom_crear_bloques(size_t capacidad, size_t bits_por_clave, size_t k) {
+
+	return crear(capacidad, bits_por_clave, k, true);
+}
+
+void bloom_agregar_hash(bloom_t *bloom, uint64_t hash) {
+
+	uint64_t h1 = mezclar(hash);
+	uint64_t h2 = mezclar(h1) | 1;
+	uint64_t* bits = bits_de(bloom, h1);
+
+	for (size_t i = 0; i < bloom->k; i++) {
+
+		size_t bit = bit_de(bloom, h1 + i * h2);
+
+		bits[bit / BITS_POR_PALABRA] |= (uint64_t) 1 << (bit % BITS_POR_PALABRA);
+	}
+
+	(bloom->cantidad)++;
+}
+
+bool bloom_puede_contener_hash(const bloom_t *bloom, uint64_t hash) {
+
+	uint64_t h1 = mezclar(hash);
+	uint64_t h2 = mezclar(h1) | 1;
+	const uint64_t* bits = bits_de(bloom, h1);
+
+	for (size_t i = 0; i < bloom->k; i++) {
+
+		size_t bit = bit_de(bloom, h1 + i * h2);
+
+		if (!((bits[bit / BITS_POR_PALABRA] >> (bit % BITS_POR_PALABRA)) & 1)) return false;
+	}
+
+	return true;
+}
+
+void bloom_agregar(bloom_t *bloom, const char *clave) {
+
+	bloom_agregar_hash(bloom, hash_clave(clave));
+}
+
+bool bloom_puede_contener(const bloom_t *bloom, const char *clave) {
+
+	return bloom_puede_contener_hash(bloom, hash_clave(clave));
+}
+
+size_t bloom_cantidad(const bloom_t *bloom) {
+
+	return bloom->cantidad;
+}
+
+size_t bloom_capacidad(const bloom_t *bloom) {
+
+	return bloom->capacidad;
+}
+
+void bloom_limpiar(bloom_t *bloom) {
+
+	memset(bloom->bits, 0, bloom->cant_bloques * TAM_LINEA);
+	bloom->cantidad = 0;
+}
+
+void bloom_destruir(bloom_t *bloom) {
+
+	free(bloom->reserva);
+	free(bloom);
+}
@@ -0,0 +1,159 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include "hash.h"
+
+// Cantidad de segmentos (potencia de dos). Acota cuántos escritores pueden
+// trabajar a la vez sin esperarse.
+#define CANT_SEGMENTOS 64
+#define TAM_LINEA 64
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+// Cada segmento ocupa sus propias líneas de memoria, para que tomar el
+// candado de uno no invalide la línea del vecino en otro procesador.
+typedef union segmento {
+	struct {
+		pthread_rwlock_t candado;
+		hash_t* hash;
+	} s;
+	char relleno[2 * TAM_LINEA];
+} segmento_t;
+
+typedef struct hash_concurrente {
+	segmento_t segmentos[CANT_SEGMENTOS];
+} hash_concurrente_t;
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+// Calcula el hash de la clave, que después se le pasa a la tabla del
+// segmento para que no lo vuelva a calcular, y devuelve el segmento al que
+// pertenece. Usa los bits altos del hash, porque los bajos son los que usa
+// la tabla del segmento. Todos los segmentos tienen la misma función de
+// hash, que no cambia, así que se calcula con el primero y sin candado.
+static segmento_t* segmento_de(hash_concurrente_t* hash, const char* clave, size_t largo, uint64_t* h) {
+
+	*h = hash_calcular_bin(hash->segmentos[0].s.hash, clave, largo);
+
+	return &hash->segmentos[*h >> 58];
+}
+
+/* ******************************************************************
+ *                 PRIMITIVAS DEL HASH CONCURRENTE
+ * *****************************************************************/
+
+hash_concurrente_t* hash_concurrente_crear(hash_destruir_dato_t destruir_dato, f_hash_t fhash) {
+
+	hash_concurrente_t* hash = malloc(sizeof(hash_concurrente_t));
+
+	if (!hash) return NULL;
+
+	for (size_t i = 0; i < CANT_SEGMENTOS; i++) {
+
+		segmento_t* segmento = &hash->segmentos[i];
+		segmento->s.hash = hash_crear(destruir_dato, fhash);
+
+		if (!segmento->s.hash || pthread_rwlock_init(&segmento->s.candado, NULL) != 0) {
+
+			if (segmento->s.hash) hash_destruir(segmento->s.hash);
+
+			for (size_t j = 0; j < i; j++) {
+
+				pthread_rwlock_destroy(&hash->segmentos[j].s.candado);
+				hash_destruir(hash->segmentos[j].s.hash);
+			}
+
+			free(hash);
+			return NULL;
+		}
+	}
+
+	return hash;
+}
+
+bool hash_concurrente_guardar(hash_concurrente_t *hash, const char *clave, void *dato) {
+
+	size_t largo = strlen(clave);
+	uint64_t h;
+	segmento_t* segmento = segmento_de(hash, clave, largo, &h);
+
+	pthread_rwlock_wrlock(&segmento->s.candado);
+	bool salida = hash_guardar_con_hash(segmento->s.hash, clave, largo, h, dato);
+	pthread_rwlock_unlock(&segmento->s.candado);
+
+	return salida;
+}
+
+void* hash_concurrente_borrar_dato(hash_concurrente_t *hash, const char *clave) {
+
+	size_t largo = strlen(clave);
+	uint64_t h;
+	segmento_t* segmento = segmento_de(hash, clave, largo, &h);
+
+	pthread_rwlock_wrlock(&segmento->s.candado);
+	void* dato = hash_borrar_dato_con_hash(segmento->s.hash, clave, largo, h);
+	pthread_rwlock_unlock(&segmento->s.candado);
+
+	return dato;
+}
+
+void* hash_concurrente_obtener(hash_concurrente_t *hash, const char *clave) {
+
+	size_t largo = strlen(clave);
+	uint64_t h;
+	segmento_t* segmento = segmento_de(hash, clave, largo, &h);
+
+	pthread_rwlock_rdlock(&segmento->s.candado);
+	void* dato = hash_obtener_con_hash(segmento->s.hash, clave, largo, h);
+	pthread_rwlock_unlock(&segmento->s.candado);
+
+	return dato;
+}
+
+bool hash_concurrente_pertenece(hash_concurrente_t *hash, const char *clave) {
+
+	size_t largo = strlen(clave);
+	uint64_t h;
+	segmento_t* segmento = segmento_de(hash, clave, largo, &h);
+
+	pthread_rwlock_rdlock(&segmento->s.candado);
+	bool salida = hash_pertenece_con_hash(segmento->s.hash, clave, largo, h);
+	pthread_rwlock_unlock(&segmento->s.candado);
+
+	return salida;
+}
+
+size_t hash_concurrente_cantidad(hash_concurrente_t *hash) {
+
+	size_t cantidad = 0;
+
+	for (size_t i = 0; i < CANT_SEGMENTOS; i++) {
+
+		segmento_t* segmento = &hash->segmentos[i];
+
+		pthread_rwlock_rdlock(&segmento->s.candado);
+		cantidad += hash_cantidad(segmento->s.hash);
+		pthread_rwlock_unlock(&segmento->s.candado);
+	}
+
+	return cantidad;
+}
+
+void hash_concurrente_destruir(hash_concurrente_t *hash) {
+
+	for (size_t i = 0; i < CANT_SEGMENTOS; i++) {
+
+		pthread_rwlock_destroy(&hash->segmentos[i].s.candado);
+		hash_destruir(hash->segmentos[i].s.hash);
+	}
+
+	free(hash);
+}
@@ -0,0 +1,60 @@
+#ifndef HASH_CONCURRENTE_H
+#define HASH_CONCURRENTE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "hash.h"
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+// Tabla de hash que puede usarse desde varios hilos a la vez.
+// Las claves se reparten en segmentos, cada uno con su propia tabla y su
+// propio candado de lectura/escritura: las escrituras sólo bloquean su
+// segmento y las lecturas no se bloquean entre sí. Cada segmento se
+// redimensiona por su cuenta mientras tiene tomado su candado de escritura.
+typedef struct hash_concurrente hash_concurrente_t;
+
+/* ******************************************************************
+ *                 PRIMITIVAS DEL HASH CONCURRENTE
+ * *****************************************************************/
+
+// Crea una tabla de Hash concurrente con una función de hash a elección.
+// Post: devuelve una nueva tabla de Hash concurrente, o NULL en caso de error.
+hash_concurrente_t* hash_concurrente_crear(hash_destruir_dato_t destruir_dato, f_hash_t fhash);
+
+// Guarda una nueva clave con su correspodiente valor asociado en el hash.
+// Pre: el hash fue creado.
+// Post: se guardó correctamente la clave con su valor.
+bool hash_concurrente_guardar(hash_concurrente_t *hash, const char *clave, void *dato);
+
+// Borra la clave y su correpondiente valor asociado en el hash.
+// Pre: el hash fue creado.
+// Post: devuelve el valor asociado a la clave (o NULL si no estaba) y retira
+// esa clave de la tabla de hash.
+void *hash_concurrente_borrar_dato(hash_concurrente_t *hash, const char *clave);
+
+// Obtiene el valor asociado a una clave.
+// Pre: el hash fue creado.
+// Post: devuelve el valor de la clave, o NULL si no estaba. El valor sigue
+// perteneciendo al hash: si otro hilo lo reemplaza o lo borra, el que lo
+// obtuvo deja de poder usarlo.
+void *hash_concurrente_obtener(hash_concurrente_t *hash, const char *clave);
+
+// Verfica si una clave pertenece o no a la tabla de hash.
+// Pre: el hash fue creado.
+// Post: devuelve verdadero o falso dependiendo de si la clave se encontraba o no en el hash.
+bool hash_concurrente_pertenece(hash_concurrente_t *hash, const char *clave);
+
+// Devuelve el número de elementos que se encuentran en el hash. Si otros
+// hilos están escribiendo, el resultado es aproximado.
+// Pre: el hash fue creado.
+size_t hash_concurrente_cantidad(hash_concurrente_t *hash);
+
+// Destruye la tabla de hash.
+// Pre: el hash fue creado y ningún otro hilo lo está usando.
+// Post: destruye el hash y todos los elementos que contenía.
+void hash_concurrente_destruir(hash_concurrente_t *hash);
+
+#endif // HASH_CONCURRENTE_H
@@ -0,0 +1,421 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash.h"
+
+/* El hash congelado es una función de hash perfecta mínima al estilo de
+ * PTHash. Las claves se reparten en baldes de unas CLAVES_POR_BALDE
+ * claves, y cada balde tiene un "piloto": un número que, combinado con el
+ * hash de cada una de sus claves, las lleva a posiciones que ninguna otra
+ * clave ocupa. Los pilotos se buscan balde por balde, empezando por los
+ * más grandes (que son los más difíciles de ubicar mientras la tabla
+ * todavía está vacía).
+ * Las posiciones van de 0 a 'posiciones', un 1% más que la cantidad de
+ * claves, porque así los pilotos se encuentran mucho antes. Las pocas
+ * claves que caen más allá de 'cantidad' se reubican en los lugares que
+ * quedaron libres, anotados en 'reubicadas'. */
+
+#define CLAVES_POR_BALDE 5
+#define POSICIONES_DE_MAS 100
+#define MAX_PILOTO UINT16_MAX
+#define MAX_INTENTOS 32
+
+// Las claves de menos de LARGO_CORTA bytes se guardan dentro de su entrada.
+#define LARGO_CORTA 16
+#define MASCARA_LARGO 0xFFFF
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+// Cada entrada ocupa 32 bytes, así que una búsqueda lee una sola línea de
+// memoria del arreglo. La firma combina los bits altos del hash con el
+// largo de la clave (en los 16 bits bajos, saturado).
+typedef struct entrada {
+	uint64_t firma;
+	void* valor;
+	union {
+		char corta[LARGO_CORTA];
+		const char* larga;
+	} clave;
+} entrada_t;
+
+typedef struct hash_congelado {
+	uint64_t semilla;
+	size_t cantidad;
+	size_t posiciones;
+	size_t cant_baldes;
+	uint16_t* pilotos;
+	uint32_t* reubicadas;
+	entrada_t* entradas;
+	char* claves;
+} hash_congelado_t;
+
+// Clave del hash original, mientras se construye el congelado.
+typedef struct pendiente {
+	const char* clave;
+	size_t largo;
+	void* valor;
+	uint64_t hash;
+} pendiente_t;
+
+typedef struct pendientes {
+	pendiente_t* claves;
+	size_t cantidad;
+} pendientes_t;
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+// Finalizador de MurmurHash3: mezcla todos los bits de h.
+static uint64_t mezclar(uint64_t h) {
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+
+	return h;
+}
+
+// FNV-1a con semilla, mezclado al final.
+static uint64_t hash_clave(const char* clave, size_t largo, uint64_t semilla) {
+
+	uint64_t h = 0xcbf29ce484222325ULL ^ semilla;
+
+	for (size_t i = 0; i < largo; i++) {
+		h ^= (unsigned char) clave[i];
+		h *= 0x100000001b3ULL;
+	}
+
+	return mezclar(h);
+}
+
+// Devuelve la firma de una clave con hash h y largo 'largo'.
+static uint64_t firma_clave(uint64_t h, size_t largo) {
+
+	return (h & ~(uint64_t) MASCARA_LARGO) | ((largo < MASCARA_LARGO) ? largo : MASCARA_LARGO);
+}
+
+// Verifica si la entrada guarda la clave, que tiene firma 'firma'.
+static bool entrada_es_clave(const entrada_t* entrada, const char* clave, size_t largo, uint64_t firma) {
+
+	if (entrada->firma != firma) return false;
+
+	if (largo < LARGO_CORTA) return memcmp(entrada->clave.corta, clave, largo) == 0;
+
+	if (largo < MASCARA_LARGO) return memcmp(entrada->clave.larga, clave, largo) == 0;
+
+	return strcmp(entrada->clave.larga, clave) == 0;
+}
+
+// Lleva x (de 32 bits) al rango [0, n) con una multiplicación en lugar de
+// una división.
+static size_t reducir(uint32_t x, size_t n) {
+
+	return (size_t) (((uint64_t) x * n) >> 32);
+}
+
+static size_t congelado_balde(const hash_congelado_t* congelado, uint64_t h) {
+
+	return reducir((uint32_t) h, congelado->cant_baldes);
+}
+
+static size_t congelado_posicion(const hash_congelado_t* congelado, uint64_t h, uint16_t piloto) {
+
+	return reducir((uint32_t) (mezclar(h + piloto * 0x9e3779b97f4a7c15ULL) >> 32), congelado->posiciones);
+}
+
+static bool ocupada(const uint64_t* ocupadas, size_t posicion) {
+
+	return (ocupadas[posicion / 64] >> (posicion % 64)) & 1;
+}
+
+static void ocupar(uint64_t* ocupadas, size_t posicion) {
+
+	ocupadas[posicion / 64] |= (uint64_t) 1 << (posicion % 64);
+}
+
+// Visitante de hash_iterar que anota cada clave del hash original.
+static bool agregar_pendiente(const char* clave, void* dato, void* extra) {
+
+	pendientes_t* pendientes = extra;
+	pendiente_t* pendiente = &pendientes->claves[(pendientes->cantidad)++];
+
+	pendiente->clave = clave;
+	pendiente->largo = strlen(clave);
+	pendiente->valor = dato;
+
+	return true;
+}
+
+// Busca un piloto que lleve las k claves del balde a posiciones libres y
+// distintas entre sí, y las ocupa, dejando en 'posicion' el lugar de cada
+// clave. Devuelve false si ningún piloto sirve.
+static bool ubicar_balde(hash_congelado_t* congelado, uint64_t* ocupadas, const pendiente_t* claves, const size_t* indices, size_t k, size_t balde, size_t* posicion) {
+
+	for (uint32_t piloto = 0; piloto <= MAX_PILOTO; piloto++) {
+
+		bool libre = true;
+
+		for (size_t j = 0; libre && j < k; j++) {
+
+			size_t p = congelado_posicion(congelado, claves[indices[j]].hash, (uint16_t) piloto);
+
+			posicion[indices[j]] = p;
+			libre = !ocupada(ocupadas, p);
+
+			for (size_t l = 0; libre && l < j; l++)
+				libre = (posicion[indices[l]] != p);
+		}
+
+		if (!libre) continue;
+
+		for (size_t j = 0; j < k; j++)
+			ocupar(ocupadas, posicion[indices[j]]);
+
+		congelado->pilotos[balde] = (uint16_t) piloto;
+
+		return true;
+	}
+
+	return false;
+}
+
+// Busca los pilotos de todos los baldes con la semilla actual y deja en
+// 'posicion' el lugar de cada clave. Devuelve false si hay que probar con
+// otra semilla (o si no hubo memoria).
+static bool buscar_pilotos(hash_congelado_t* congelado, pendiente_t* claves, size_t* posicion) {
+
+	size_t n = congelado->cantidad;
+	size_t cant_baldes = congelado->cant_baldes;
+
+	size_t* inicio = calloc(cant_baldes + 1, sizeof(size_t));
+	size_t* siguiente = malloc(sizeof(size_t) * cant_baldes);
+	size_t* indices = malloc(sizeof(size_t) * (n + 1));
+	uint64_t* ocupadas = calloc(congelado->posiciones / 64 + 1, sizeof(uint64_t));
+	bool exito = inicio && siguiente && indices && ocupadas;
+
+	if (exito) {
+
+		// Agrupa las claves por balde (ordenamiento por conteo).
+		size_t max_tam = 0;
+
+		for (size_t i = 0; i < n; i++) {
+			claves[i].hash = hash_clave(claves[i].clave, claves[i].largo, congelado->semilla);
+			(inicio[congelado_balde(congelado, claves[i].hash) + 1])++;
+		}
+
+		for (size_t b = 0; b < cant_baldes; b++) {
+			if (inicio[b + 1] > max_tam) max_tam = inicio[b + 1];
+			inicio[b + 1] += inicio[b];
+		}
+
+		memcpy(siguiente, inicio, sizeof(size_t) * cant_baldes);
+
+		for (size_t i = 0; i < n; i++)
+			indices[(siguiente[congelado_balde(congelado, claves[i].hash)])++] = i;
+
+		// Ubica los baldes de mayor a menor cantidad de claves.
+		for (size_t tam = max_tam; exito && tam > 0; tam--) {
+
+			for (size_t b = 0; exito && b < cant_baldes; b++) {
+
+				if (inicio[b + 1] - inicio[b] != tam) continue;
+
+				exito = ubicar_balde(congelado, ocupadas, claves, &indices[inicio[b]], tam, b, posicion);
+			}
+		}
+	}
+
+	free(inicio);
+	free(siguiente);
+	free(indices);
+	free(ocupadas);
+
+	return exito;
+}
+
+// Pasa las claves que cayeron más allá de 'cantidad' a los lugares que
+// quedaron libres, anotándolos en 'reubicadas'.
+static bool reubicar(hash_congelado_t* congelado, const size_t* posicion) {
+
+	size_t n = congelado->cantidad;
+	bool* tomada = calloc(congelado->posiciones + 1, sizeof(bool));
+
+	if (!tomada) return false;
+
+	for (size_t i = 0; i < n; i++)
+		tomada[posicion[i]] = true;
+
+	size_t libre = 0;
+
+	for (size_t p = n; p < congelado->posiciones; p++) {
+
+		congelado->reubicadas[p - n] = 0;
+
+		if (!tomada[p]) continue;
+
+		while (tomada[libre]) libre++;
+
+		congelado->reubicadas[p - n] = (uint32_t) libre;
+		tomada[libre] = true;
+	}
+
+	free(tomada);
+
+	return true;
+}
+
+// Construye el hash congelado con las claves pendientes.
+static bool congelado_construir(hash_congelado_t* congelado, pendientes_t* pendientes) {
+
+	size_t n = pendientes->cantidad;
+	size_t largo_claves = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		if (pendientes->claves[i].largo >= LARGO_CORTA) largo_claves += pendientes->claves[i].largo + 1;
+	}
+
+	congelado->cantidad = n;
+	congelado->posiciones = n + n / POSICIONES_DE_MAS;
+	congelado->cant_baldes = n / CLAVES_POR_BALDE + 1;
+	// Los baldes sin claves no reciben piloto, pero las búsquedas de claves
+	// ausentes también los leen: quedan en 0.
+	congelado->pilotos = calloc(congelado->cant_baldes, sizeof(uint16_t));
+	congelado->reubicadas = malloc(sizeof(uint32_t) * (congelado->posiciones - n + 1));
+	congelado->entradas = malloc(sizeof(entrada_t) * (n + 1));
+	congelado->claves = malloc(largo_claves + 1);
+
+	size_t* posicion = malloc(sizeof(size_t) * (n + 1));
+	bool exito = congelado->pilotos && congelado->reubicadas && congelado->entradas && congelado->claves && posicion;
+
+	if (exito) {
+
+		exito = false;
+
+		for (uint64_t intento = 0; !exito && intento < MAX_INTENTOS; intento++) {
+
+			congelado->semilla = mezclar(intento + 1);
+			exito = buscar_pilotos(congelado, pendientes->claves, posicion);
+		}
+	}
+
+	exito = exito && reubicar(congelado, posicion);
+
+	char* destino = congelado->claves;
+
+	for (size_t i = 0; exito && i < n; i++) {
+
+		const pendiente_t* pendiente = &pendientes->claves[i];
+		size_t p = posicion[i];
+
+		if (p >= n) p = congelado->reubicadas[p - n];
+
+		entrada_t* entrada = &congelado->entradas[p];
+
+		entrada->firma = firma_clave(pendiente->hash, pendiente->largo);
+		entrada->valor = pendiente->valor;
+
+		if (pendiente->largo < LARGO_CORTA) {
+			memcpy(entrada->clave.corta, pendiente->clave, pendiente->largo);
+			continue;
+		}
+
+		memcpy(destino, pendiente->clave, pendiente->largo + 1);
+		entrada->clave.larga = destino;
+		destino += pendiente->largo + 1;
+	}
+
+	free(posicion);
+
+	return exito;
+}
+
+// Libera el hash congelado y todo lo que tenga reservado.
+static void congelado_liberar(hash_congelado_t* congelado) {
+
+	free(congelado->pilotos);
+	free(congelado->reubicadas);
+	free(congelado->entradas);
+	free(congelado->claves);
+	free(congelado);
+}
+
+// Devuelve la entrada en la que tendría que estar la clave.
+static const entrada_t* congelado_entrada(const hash_congelado_t* congelado, uint64_t h) {
+
+	size_t p = congelado_posicion(congelado, h, congelado->pilotos[congelado_balde(congelado, h)]);
+
+	if (p >= congelado->cantidad) p = congelado->reubicadas[p - congelado->cantidad];
+
+	return &congelado->entradas[p];
+}
+
+/* ******************************************************************
+ *                 PRIMITIVAS DEL HASH CONGELADO
+ * *****************************************************************/
+
+hash_congelado_t* hash_congelar(const hash_t *hash) {
+
+	size_t n = hash_cantidad(hash);
+
+	if (n > UINT32_MAX) return NULL;
+
+	hash_congelado_t* congelado = calloc(1, sizeof(hash_congelado_t));
+
+	if (!congelado) return NULL;
+
+	pendientes_t pendientes = { malloc(sizeof(pendiente_t) * (n + 1)), 0 };
+
+	if (!pendientes.claves) {
+		free(congelado);
+		return NULL;
+	}
+
+	hash_iterar(hash, agregar_pendiente, &pendientes);
+
+	bool exito = congelado_construir(congelado, &pendientes);
+
+	free(pendientes.claves);
+
+	if (!exito) {
+		congelado_liberar(congelado);
+		return NULL;
+	}
+
+	return congelado;
+}
+
+void *hash_congelado_obtener(const hash_congelado_t *congelado, const char *clave) {
+
+	if (congelado->cantidad == 0) return NULL;
+
+	size_t largo = strlen(clave);
+	uint64_t h = hash_clave(clave, largo, congelado->semilla);
+	const entrada_t* entrada = congelado_entrada(congelado, h);
+
+	return entrada_es_clave(entrada, clave, largo, firma_clave(h, largo)) ? entrada->valor : NULL;
+}
+
+bool hash_congelado_pertenece(const hash_congelado_t *congelado, const char *clave) {
+
+	if (congelado->cantidad == 0) return false;
+
+	size_t largo = strlen(clave);
+	uint64_t h = hash_clave(clave, largo, congelado->semilla);
+	return entrada_es_clave(congelado_entrada(congelado, h), clave, largo, firma_clave(h, largo));
+}
+
+size_t hash_congelado_cantidad(const hash_congelado_t *congelado) {
+
+	return congelado->cantidad;
+}
+
+void hash_congelado_destruir(hash_congelado_t *congelado) {
+
+	congelado_liberar(congelado);
+}
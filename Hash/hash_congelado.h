@@ -0,0 +1,49 @@
+#ifndef HASH_CONGELADO_H
+#define HASH_CONGELADO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "hash.h"
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+// Copia de sólo lectura de una tabla de hash, para claves que no van a
+// cambiar. Usa una función de hash perfecta mínima: cada clave guardada
+// tiene su propia posición en un arreglo de exactamente tantas entradas
+// como claves, así que una búsqueda lee una sola entrada, sin cadenas ni
+// sondeos. Para ubicar esa posición guarda unos 3,5 bits por clave.
+typedef struct hash_congelado hash_congelado_t;
+
+/* ******************************************************************
+ *                 PRIMITIVAS DEL HASH CONGELADO
+ * *****************************************************************/
+
+// Crea un hash congelado con las claves y valores del hash recibido.
+// Las claves se copian; los valores no: siguen perteneciendo al hash
+// original, que puede seguir usándose (sin que sus cambios se vean en el
+// congelado) o destruirse sin destruir sus datos.
+// Pre: el hash fue creado. Sus claves son cadenas (no contienen '\0').
+// Post: devuelve el hash congelado, o NULL si no hubo memoria.
+hash_congelado_t* hash_congelar(const hash_t *hash);
+
+// Obtiene el valor asociado a una clave.
+// Pre: el hash congelado fue creado.
+// Post: devuelve el valor de la clave, o NULL si no estaba.
+void *hash_congelado_obtener(const hash_congelado_t *congelado, const char *clave);
+
+// Verfica si una clave pertenece o no al hash congelado.
+// Pre: el hash congelado fue creado.
+// Post: devuelve verdadero o falso dependiendo de si la clave se encontraba o no.
+bool hash_congelado_pertenece(const hash_congelado_t *congelado, const char *clave);
+
+// Devuelve el número de claves del hash congelado.
+// Pre: el hash congelado fue creado.
+size_t hash_congelado_cantidad(const hash_congelado_t *congelado);
+
+// Destruye el hash congelado. No destruye los valores.
+// Pre: el hash congelado fue creado.
+void hash_congelado_destruir(hash_congelado_t *congelado);
+
+#endif // HASH_CONGELADO_H
@@ -0,0 +1,264 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "hash.h"
+
+// Tamaño inicial de la tabla (potencia de dos).
+#define TAM_INICIAL 16
+
+// La tabla se duplica cuando pasaría a estar ocupada en más de la mitad:
+// con sondeo lineal las búsquedas siguen recorriendo pocas ranuras seguidas.
+#define CARGA_MAXIMA_NUM 1
+#define CARGA_MAXIMA_DEN 2
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+// Una ranura con clave 0 está vacía. Por eso la clave 0 no se guarda
+// en la tabla sino aparte, en hay_cero y valor_cero.
+typedef struct ranura {
+	uint64_t clave;
+	void* valor;
+} ranura_t;
+
+typedef struct hash_entero {
+	ranura_t* ranuras;
+	size_t tamanio;
+	size_t cantidad;
+	bool hay_cero;
+	void* valor_cero;
+	hash_destruir_dato_t destruir_dato;
+} hash_entero_t;
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+// Mezcla los bits de la clave (finalizador de MurmurHash3), para que claves
+// consecutivas no caigan en ranuras consecutivas.
+static uint64_t mezclar(uint64_t h) {
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+
+	return h;
+}
+
+static size_t ranura_inicial(const hash_entero_t* hash, uint64_t clave) {
+
+	return mezclar(clave) & (hash->tamanio - 1);
+}
+
+// Devuelve la ranura que contiene la clave (distinta de 0), o la ranura
+// vacía donde terminó la búsqueda si no está.
+static ranura_t* buscar(const hash_entero_t* hash, uint64_t clave) {
+
+	size_t mascara = hash->tamanio - 1;
+	size_t i = ranura_inicial(hash, clave);
+
+	while (hash->ranuras[i].clave != 0 && hash->ranuras[i].clave != clave)
+		i = (i + 1) & mascara;
+
+	return &hash->ranuras[i];
+}
+
+// Cantidad de elementos guardados en la tabla (sin contar la clave 0).
+static size_t cantidad_en_tabla(const hash_entero_t* hash) {
+
+	return hash->cantidad - (hash->hay_cero ? 1 : 0);
+}
+
+static bool redimensionar(hash_entero_t* hash, size_t nuevo_tamanio) {
+
+	ranura_t* nuevas = calloc(nuevo_tamanio, sizeof(ranura_t));
+
+	if (!nuevas) return false;
+
+	ranura_t* viejas = hash->ranuras;
+	size_t tamanio_viejo = hash->tamanio;
+
+	hash->ranuras = nuevas;
+	hash->tamanio = nuevo_tamanio;
+
+	for (size_t i = 0; i < tamanio_viejo; i++) {
+
+		if (viejas[i].clave == 0) continue;
+
+		*buscar(hash, viejas[i].clave) = viejas[i];
+	}
+
+	free(viejas);
+
+	return true;
+}
+
+// Retira la ranura i corriendo hacia atrás los elementos que le siguen en
+// la misma corrida, de modo que ninguna búsqueda quede cortada por un hueco.
+static void vaciar_ranura(hash_entero_t* hash, size_t i) {
+
+	size_t mascara = hash->tamanio - 1;
+	size_t j = i;
+
+	while (true) {
+
+		j = (j + 1) & mascara;
+
+		if (hash->ranuras[j].clave == 0) break;
+
+		size_t inicial = ranura_inicial(hash, hash->ranuras[j].clave);
+
+		// El elemento de j puede pasar a i sólo si su ranura inicial no
+		// está (circularmente) entre i y j.
+		if (((j - inicial) & mascara) >= ((j - i) & mascara)) {
+
+			hash->ranuras[i] = hash->ranuras[j];
+			i = j;
+		}
+	}
+
+	hash->ranuras[i].clave = 0;
+	hash->ranuras[i].valor = NULL;
+}
+
+/* ******************************************************************
+ *                  PRIMITIVAS DEL HASH DE ENTEROS
+ * *****************************************************************/
+
+hash_entero_t* hash_entero_crear(hash_destruir_dato_t destruir_dato) {
+
+	hash_entero_t* hash = malloc(sizeof(hash_entero_t));
+
+	if (!hash) return NULL;
+
+	hash->ranuras = calloc(TAM_INICIAL, sizeof(ranura_t));
+
+	if (!hash->ranuras) {
+
+		free(hash);
+		return NULL;
+	}
+
+	hash->tamanio = TAM_INICIAL;
+	hash->cantidad = 0;
+	hash->hay_cero = false;
+	hash->valor_cero = NULL;
+	hash->destruir_dato = destruir_dato;
+
+	return hash;
+}
+
+bool hash_entero_guardar(hash_entero_t *hash, uint64_t clave, void *dato) {
+
+	if (clave == 0) {
+
+		if (hash->hay_cero && hash->destruir_dato) hash->destruir_dato(hash->valor_cero);
+		if (!hash->hay_cero) (hash->cantidad)++;
+
+		hash->hay_cero = true;
+		hash->valor_cero = dato;
+
+		return true;
+	}
+
+	ranura_t* ranura = buscar(hash, clave);
+
+	if (ranura->clave == clave) {
+
+		if (hash->destruir_dato) hash->destruir_dato(ranura->valor);
+
+		ranura->valor = dato;
+
+		return true;
+	}
+
+	if ((cantidad_en_tabla(hash) + 1) * CARGA_MAXIMA_DEN > hash->tamanio * CARGA_MAXIMA_NUM) {
+
+		if (!redimensionar(hash, hash->tamanio * 2)) return false;
+
+		ranura = buscar(hash, clave);
+	}
+
+	ranura->clave = clave;
+	ranura->valor = dato;
+	(hash->cantidad)++;
+
+	return true;
+}
+
+void *hash_entero_borrar_dato(hash_entero_t *hash, uint64_t clave) {
+
+	void* dato;
+
+	if (clave == 0) {
+
+		if (!hash->hay_cero) return NULL;
+
+		dato = hash->valor_cero;
+		hash->hay_cero = false;
+		hash->valor_cero = NULL;
+		(hash->cantidad)--;
+
+		return dato;
+	}
+
+	ranura_t* ranura = buscar(hash, clave);
+
+	if (ranura->clave == 0) return NULL;
+
+	dato = ranura->valor;
+	vaciar_ranura(hash, (size_t) (ranura - hash->ranuras));
+	(hash->cantidad)--;
+
+	return dato;
+}
+
+void *hash_entero_obtener(const hash_entero_t *hash, uint64_t clave) {
+
+	if (clave == 0) return hash->valor_cero;
+
+	return buscar(hash, clave)->valor;
+}
+
+bool hash_entero_pertenece(const hash_entero_t *hash, uint64_t clave) {
+
+	if (clave == 0) return hash->hay_cero;
+
+	return buscar(hash, clave)->clave != 0;
+}
+
+size_t hash_entero_cantidad(const hash_entero_t *hash) {
+
+	return hash->cantidad;
+}
+
+void hash_entero_iterar(const hash_entero_t *hash, bool (*visitar)(uint64_t clave, void *dato, void *extra), void *extra) {
+
+	if (hash->hay_cero && !visitar(0, hash->valor_cero, extra)) return;
+
+	for (size_t i = 0; i < hash->tamanio; i++) {
+
+		if (hash->ranuras[i].clave == 0) continue;
+
+		if (!visitar(hash->ranuras[i].clave, hash->ranuras[i].valor, extra)) return;
+	}
+}
+
+void hash_entero_destruir(hash_entero_t *hash) {
+
+	if (hash->destruir_dato) {
+
+		if (hash->hay_cero) hash->destruir_dato(hash->valor_cero);
+
+		for (size_t i = 0; i < hash->tamanio; i++) {
+
+			if (hash->ranuras[i].clave != 0) hash->destruir_dato(hash->ranuras[i].valor);
+		}
+	}
+
+	free(hash->ranuras);
+	free(hash);
+}
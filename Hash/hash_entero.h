@@ -0,0 +1,63 @@
+#ifndef HASH_ENTERO_H
+#define HASH_ENTERO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hash.h"
+
+/* ******************************************************************
+ *                DEFINICION DE LOS TIPOS DE DATOS
+ * *****************************************************************/
+
+// Tabla de hash cuyas claves son enteros de 64 bits.
+// Las claves se guardan directamente en las ranuras de la tabla, junto a
+// su valor: guardar no copia ni reserva nada por clave, y buscar compara
+// enteros en lugar de cadenas.
+typedef struct hash_entero hash_entero_t;
+
+/* ******************************************************************
+ *                  PRIMITIVAS DEL HASH DE ENTEROS
+ * *****************************************************************/
+
+// Crea una tabla de Hash de claves enteras.
+// Post: devuelve una nueva tabla de Hash, o NULL en caso de error.
+hash_entero_t* hash_entero_crear(hash_destruir_dato_t destruir_dato);
+
+// Guarda una nueva clave con su correspodiente valor asociado en el hash.
+// Si la clave ya estaba, reemplaza (y destruye) su valor anterior.
+// Pre: el hash fue creado.
+// Post: se guardó correctamente la clave con su valor.
+bool hash_entero_guardar(hash_entero_t *hash, uint64_t clave, void *dato);
+
+// Borra la clave y su correpondiente valor asociado en el hash.
+// Pre: el hash fue creado.
+// Post: devuelve el valor asociado a la clave (o NULL si no estaba) y retira
+// esa clave de la tabla de hash.
+void *hash_entero_borrar_dato(hash_entero_t *hash, uint64_t clave);
+
+// Obtiene el valor asociado a una clave.
+// Pre: el hash fue creado.
+// Post: devuelve el valor de la clave, o NULL si no estaba.
+void *hash_entero_obtener(const hash_entero_t *hash, uint64_t clave);
+
+// Verfica si una clave pertenece o no a la tabla de hash.
+// Pre: el hash fue creado.
+// Post: devuelve verdadero o falso dependiendo de si la clave se encontraba o no en el hash.
+bool hash_entero_pertenece(const hash_entero_t *hash, uint64_t clave);
+
+// Devuelve el número de elementos que se encuentran en el hash.
+// Pre: el hash fue creado.
+size_t hash_entero_cantidad(const hash_entero_t *hash);
+
+// Aplica visitar a cada par (clave, valor) del hash, en un orden cualquiera,
+// hasta recorrerlos todos o hasta que visitar devuelva false.
+// Pre: el hash fue creado y no se modifica durante el recorrido.
+void hash_entero_iterar(const hash_entero_t *hash, bool (*visitar)(uint64_t clave, void *dato, void *extra), void *extra);
+
+// Destruye la tabla de hash.
+// Pre: el hash fue creado.
+// Post: destruye el hash y todos los elementos que contenía.
+void hash_entero_destruir(hash_entero_t *hash);
+
+#endif // HASH_ENTERO_H
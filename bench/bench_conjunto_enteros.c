@@ -0,0 +1,212 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "conjunto.h"
+
+/* Mide conjunto_interseccion y conjunto_union entre dos conjuntos de
+ * enteros (conjunto_crear_enteros) al azar, con distintas proporciones de
+ * elementos en común. Conjunto/conjunto.c elige al compilar el núcleo de
+ * bloques según las instrucciones habilitadas, así que el Makefile compila
+ * este programa tres veces: sin instrucciones vectoriales, con SSSE3 y
+ * SSE4.1, y con AVX2 y BMI2. Cada medición es el mínimo de varias
+ * repeticiones, y los resultados se comparan con una mezcla simple.
+ *
+ * Uso: ./bench_conjunto_enteros_<nucleo> [elementos [repeticiones]]
+ * Por defecto 1M elementos y 15 repeticiones. */
+
+#define ELEMENTOS_POR_DEFECTO 1000000
+#define REPETICIONES_POR_DEFECTO 15
+
+#if defined(__AVX2__) && defined(__BMI2__)
+#define NUCLEO "avx2+bmi2"
+#elif defined(__SSSE3__) && defined(__SSE4_1__)
+#define NUCLEO "ssse3+sse4.1"
+#else
+#define NUCLEO "escalar"
+#endif
+
+typedef struct caso {
+	const char* nombre;
+	size_t divisor_a;	// El primer conjunto tiene elementos / divisor_a.
+	double rango;		// Los enteros se eligen en [0, rango * elementos).
+} caso_t;
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+static uint64_t azar(uint64_t* estado) {
+
+	*estado ^= *estado << 13;
+	*estado ^= *estado >> 7;
+	*estado ^= *estado << 17;
+
+	return *estado;
+}
+
+static double ahora(void) {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double) t.tv_sec + (double) t.tv_nsec / 1e9;
+}
+
+static int comparar_enteros(const void* a, const void* b) {
+
+	uint32_t x = *(const uint32_t*) a, y = *(const uint32_t*) b;
+
+	return (x > y) - (x < y);
+}
+
+// Llena 'enteros' con n enteros distintos al azar en [0, rango), ordenados,
+// y devuelve cuántos quedaron.
+static size_t generar(uint32_t* enteros, size_t n, uint32_t rango, uint64_t* estado) {
+
+	for (size_t i = 0; i < n; i++)
+		enteros[i] = (uint32_t) (azar(estado) % rango);
+
+	qsort(enteros, n, sizeof(uint32_t), comparar_enteros);
+
+	size_t distintos = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		if (distintos == 0 || enteros[distintos - 1] != enteros[i]) enteros[distintos++] = enteros[i];
+	}
+
+	return distintos;
+}
+
+static conjunto_t* crear(const uint32_t* enteros, size_t n) {
+
+	conjunto_t* conjunto = conjunto_crear_enteros((int) n);
+
+	for (size_t i = 0; conjunto && i < n; i++)
+		conjunto_agregar_entero(conjunto, enteros[i]);
+
+	return conjunto;
+}
+
+// Verifica que 'resultado' tenga los 'esperados' enteros de 'referencia'.
+static void verificar(conjunto_t* resultado, const uint32_t* referencia, size_t esperados, uint32_t* copia, const char* operacion) {
+
+	if (!resultado || conjunto_copiar_enteros(resultado, copia, esperados + 1) != esperados ||
+		memcmp(copia, referencia, esperados * sizeof(uint32_t)) != 0) {
+		fprintf(stderr, "error: la %s no coincide con la referencia\n", operacion);
+		exit(1);
+	}
+}
+
+/* ******************************************************************
+ *                        PROGRAMA PRINCIPAL
+ * *****************************************************************/
+
+int main(int argc, char* argv[]) {
+
+	size_t n = (argc > 1) ? strtoul(argv[1], NULL, 10) : ELEMENTOS_POR_DEFECTO;
+	size_t repeticiones = (argc > 2) ? strtoul(argv[2], NULL, 10) : REPETICIONES_POR_DEFECTO;
+
+	if (n < 100 || n > UINT32_MAX / 400 || repeticiones == 0) {
+		fprintf(stderr, "uso: %s [elementos (100 a %u) [repeticiones]]\n", argv[0], UINT32_MAX / 400);
+		return 1;
+	}
+
+	// Cuanto menor el rango, más enteros en común; la columna 'comunes'
+	// muestra cuántos hay en cada caso.
+	caso_t casos[] = {
+		{ "n x n, rango 200n", 1, 200 },
+		{ "n x n, rango 10n", 1, 10 },
+		{ "n x n, rango 2n", 1, 2 },
+		{ "n x n, rango 1.05n", 1, 1.05 },
+		{ "n/10 x n, rango 2n", 10, 2 }
+	};
+
+	uint32_t* a = malloc(sizeof(uint32_t) * n);
+	uint32_t* b = malloc(sizeof(uint32_t) * n);
+	uint32_t* referencia = malloc(sizeof(uint32_t) * 2 * n);
+	uint32_t* copia = malloc(sizeof(uint32_t) * (2 * n + 1));
+
+	if (!a || !b || !referencia || !copia) {
+		fprintf(stderr, "no hay memoria\n");
+		return 1;
+	}
+
+	uint64_t estado = 0x9e3779b97f4a7c15ULL;
+
+	printf("nucleo %s, %zu elementos, minimo de %zu repeticiones (ms)\n\n", NUCLEO, n, repeticiones);
+	printf("%-20s %10s %10s %10s\n", "caso", "comunes", "intersec.", "union");
+
+	for (size_t c = 0; c < sizeof(casos) / sizeof(casos[0]); c++) {
+
+		uint32_t rango = (uint32_t) (casos[c].rango * n);
+		size_t na = generar(a, n / casos[c].divisor_a, rango, &estado);
+		size_t nb = generar(b, n, rango, &estado);
+
+		conjunto_t* conjunto_a = crear(a, na);
+		conjunto_t* conjunto_b = crear(b, nb);
+
+		if (!conjunto_a || !conjunto_b) {
+			fprintf(stderr, "no hay memoria\n");
+			return 1;
+		}
+
+		// Las referencias se arman con una mezcla simple y comparten el
+		// arreglo: primero la de la intersección y después la de la unión.
+		size_t comunes = 0;
+
+		for (size_t i = 0, j = 0; i < na && j < nb; ) {
+			if (a[i] < b[j]) i++;
+			else if (a[i] > b[j]) j++;
+			else { referencia[comunes++] = a[i]; i++; j++; }
+		}
+
+		double interseccion = 1e9, union_ = 1e9;
+
+		for (size_t r = 0; r < repeticiones; r++) {
+
+			double inicio = ahora();
+			conjunto_t* resultado = conjunto_interseccion(conjunto_a, conjunto_b);
+			double segundos = ahora() - inicio;
+
+			if (segundos < interseccion) interseccion = segundos;
+			if (r == 0) verificar(resultado, referencia, comunes, copia, "interseccion");
+
+			conjunto_destruir(resultado);
+		}
+
+		size_t unidos = 0, i = 0, j = 0;
+
+		while (i < na || j < nb) {
+			if (j == nb || (i < na && a[i] < b[j])) referencia[unidos++] = a[i++];
+			else if (i == na || b[j] < a[i]) referencia[unidos++] = b[j++];
+			else { referencia[unidos++] = a[i]; i++; j++; }
+		}
+
+		for (size_t r = 0; r < repeticiones; r++) {
+
+			double inicio = ahora();
+			conjunto_t* resultado = conjunto_union(conjunto_a, conjunto_b);
+			double segundos = ahora() - inicio;
+
+			if (segundos < union_) union_ = segundos;
+			if (r == 0) verificar(resultado, referencia, unidos, copia, "union");
+
+			conjunto_destruir(resultado);
+		}
+
+		printf("%-20s %10zu %10.2f %10.2f\n", casos[c].nombre, comunes, interseccion * 1e3, union_ * 1e3);
+
+		conjunto_destruir(conjunto_a);
+		conjunto_destruir(conjunto_b);
+	}
+
+	free(a);
+	free(b);
+	free(referencia);
+	free(copia);
+
+	return 0;
+}
@@ -0,0 +1,285 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "hash.h"
+
+/* Mide las funciones de hash de Hash/hash.c sobre tres corpus de claves
+ * generados acá: URLs, UUIDs e identificadores secuenciales. Para cada
+ * función informa cuántos MB por segundo procesa, qué tan parejo reparte
+ * las claves en 'baldes' baldes y cuántas claves tienen el mismo hash de
+ * 64 bits que otra.
+ *
+ * Uso: ./bench_fhash [claves [baldes]]   (por defecto 200000 y 4096)
+ *
+ * Las tablas eligen el balde con los bits bajos del hash ya mezclado
+ * (mezclar(h) & (tamanio - 1)), así que el reparto se mide con máscara y
+ * dos veces: con el hash tal cual, que muestra la calidad de la función,
+ * y mezclado, que es lo que ven las tablas. Para una función uniforme el
+ * chi cuadrado ronda baldes - 1, con un desvío de raíz de 2 * (baldes - 1). */
+
+#define CLAVES_POR_DEFECTO 200000
+#define BALDES_POR_DEFECTO 4096
+#define LARGO_MAXIMO_CLAVE 128
+
+// La medición de velocidad se repite hasta procesar al menos estos bytes.
+#define BYTES_MINIMOS (64 * 1024 * 1024)
+
+typedef struct funcion {
+	const char* nombre;
+	f_hash_t fhash;
+} funcion_t;
+
+typedef struct corpus {
+	const char* nombre;
+	char* *claves;
+	size_t *largos;
+	size_t cantidad;
+	size_t bytes;
+} corpus_t;
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+// La función de hash rotativa que usaba hash_crear por defecto, para comparar.
+static uint64_t rotativa(const char* clave, size_t largo) {
+
+	uint64_t hash = 0;
+
+	for (size_t i = 0; i < largo; i++)
+		hash = ((hash<<4)^(hash>>28)^clave[i]);
+
+	return hash;
+}
+
+// La misma mezcla que aplica Hash/hash.c antes de elegir el balde.
+static uint64_t mezclar(uint64_t h) {
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+
+	return h;
+}
+
+// xorshift64: el generador es fijo para que los corpus sean los mismos en
+// cada corrida.
+static uint64_t azar(uint64_t* estado) {
+
+	*estado ^= *estado << 13;
+	*estado ^= *estado >> 7;
+	*estado ^= *estado << 17;
+
+	return *estado;
+}
+
+static double ahora(void) {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double) t.tv_sec + (double) t.tv_nsec / 1e9;
+}
+
+static int comparar_hashes(const void* a, const void* b) {
+
+	uint64_t x = *(const uint64_t*) a;
+	uint64_t y = *(const uint64_t*) b;
+
+	return (x > y) - (x < y);
+}
+
+static void escribir_url(char* clave, size_t i, uint64_t* estado) {
+
+	static const char* dominios[] = { "ejemplo", "tienda", "noticias", "foro", "universidad", "banco", "mapas", "videos" };
+	static const char* secciones[] = { "productos", "articulos", "usuarios", "busqueda", "categoria", "api/v2/items" };
+	static const char* palabras[] = { "zapatillas", "mesa", "lampara", "teclado", "libro", "camisa", "auriculares", "silla" };
+
+	snprintf(clave, LARGO_MAXIMO_CLAVE, "https://www.%s.com.ar/%s/%s-%s-%zu?ref=%u",
+		dominios[azar(estado) % 8], secciones[azar(estado) % 6],
+		palabras[azar(estado) % 8], palabras[azar(estado) % 8], i,
+		(unsigned) (azar(estado) % 1000));
+}
+
+static void escribir_uuid(char* clave, size_t i, uint64_t* estado) {
+
+	uint64_t alto = azar(estado), bajo = azar(estado);
+
+	(void) i;
+
+	// Versión 4, variante 10.
+	alto = (alto & ~(uint64_t) 0xf000) | 0x4000;
+	bajo = (bajo & ~((uint64_t) 0x3 << 62)) | ((uint64_t) 0x2 << 62);
+
+	snprintf(clave, LARGO_MAXIMO_CLAVE, "%08x-%04x-%04x-%04x-%012llx",
+		(unsigned) (alto >> 32), (unsigned) ((alto >> 16) & 0xffff), (unsigned) (alto & 0xffff),
+		(unsigned) (bajo >> 48), (unsigned long long) (bajo & 0xffffffffffffULL));
+}
+
+static void escribir_secuencial(char* clave, size_t i, uint64_t* estado) {
+
+	(void) estado;
+
+	snprintf(clave, LARGO_MAXIMO_CLAVE, "%zu", 10000000 + i);
+}
+
+static bool corpus_crear(corpus_t* corpus, const char* nombre, size_t cantidad, void (*escribir)(char*, size_t, uint64_t*)) {
+
+	uint64_t estado = 0x9e3779b97f4a7c15ULL;
+
+	corpus->nombre = nombre;
+	corpus->cantidad = cantidad;
+	corpus->bytes = 0;
+	corpus->claves = malloc(sizeof(char*) * cantidad);
+	corpus->largos = malloc(sizeof(size_t) * cantidad);
+
+	char* texto = malloc(LARGO_MAXIMO_CLAVE * cantidad);
+
+	if (!corpus->claves || !corpus->largos || !texto) {
+		free(corpus->claves);
+		free(corpus->largos);
+		free(texto);
+		return false;
+	}
+
+	for (size_t i = 0; i < cantidad; i++) {
+		corpus->claves[i] = texto + i * LARGO_MAXIMO_CLAVE;
+		escribir(corpus->claves[i], i, &estado);
+		corpus->largos[i] = strlen(corpus->claves[i]);
+		corpus->bytes += corpus->largos[i];
+	}
+
+	return true;
+}
+
+static void corpus_destruir(corpus_t* corpus) {
+
+	free(corpus->claves[0]);
+	free(corpus->claves);
+	free(corpus->largos);
+}
+
+// Devuelve el chi cuadrado de repartir los hashes en 'baldes' baldes (una
+// potencia de 2) con sus bits bajos.
+static double chi_cuadrado(const uint64_t* hashes, size_t n, size_t baldes, size_t* ocupacion) {
+
+	memset(ocupacion, 0, sizeof(size_t) * baldes);
+
+	for (size_t i = 0; i < n; i++)
+		(ocupacion[hashes[i] & (baldes - 1)])++;
+
+	double esperado = (double) n / baldes;
+	double chi = 0;
+
+	for (size_t i = 0; i < baldes; i++) {
+
+		double desvio = (double) ocupacion[i] - esperado;
+
+		chi += desvio * desvio / esperado;
+	}
+
+	return chi;
+}
+
+static void medir(const funcion_t* funcion, const corpus_t* corpus, size_t baldes, uint64_t* hashes, size_t* ocupacion) {
+
+	// El resultado de cada pasada se acumula para que no se descarte el cálculo.
+	size_t pasadas = BYTES_MINIMOS / (corpus->bytes + 1) + 1;
+	volatile uint64_t acumulado = 0;
+	double inicio = ahora();
+
+	for (size_t pasada = 0; pasada < pasadas; pasada++) {
+
+		uint64_t suma = 0;
+
+		for (size_t i = 0; i < corpus->cantidad; i++)
+			suma += funcion->fhash(corpus->claves[i], corpus->largos[i]);
+
+		acumulado += suma;
+	}
+
+	double segundos = ahora() - inicio;
+	double mb_por_segundo = (double) corpus->bytes * pasadas / segundos / 1e6;
+
+	for (size_t i = 0; i < corpus->cantidad; i++)
+		hashes[i] = funcion->fhash(corpus->claves[i], corpus->largos[i]);
+
+	double chi_crudo = chi_cuadrado(hashes, corpus->cantidad, baldes, ocupacion);
+
+	qsort(hashes, corpus->cantidad, sizeof(uint64_t), comparar_hashes);
+
+	size_t colisiones = 0;
+
+	for (size_t i = 1; i < corpus->cantidad; i++) {
+		if (hashes[i] == hashes[i - 1]) colisiones++;
+	}
+
+	for (size_t i = 0; i < corpus->cantidad; i++)
+		hashes[i] = mezclar(hashes[i]);
+
+	double chi_mezclado = chi_cuadrado(hashes, corpus->cantidad, baldes, ocupacion);
+
+	printf("%-12s %-10s %10.0f %14.0f %14.0f %11zu\n", corpus->nombre, funcion->nombre,
+		mb_por_segundo, chi_crudo, chi_mezclado, colisiones);
+}
+
+/* ******************************************************************
+ *                        PROGRAMA PRINCIPAL
+ * *****************************************************************/
+
+int main(int argc, char* argv[]) {
+
+	size_t cantidad = (argc > 1) ? strtoul(argv[1], NULL, 10) : CLAVES_POR_DEFECTO;
+	size_t baldes = 1;
+	size_t pedidos = (argc > 2) ? strtoul(argv[2], NULL, 10) : BALDES_POR_DEFECTO;
+
+	// Las tablas usan potencias de 2.
+	while (baldes < pedidos)
+		baldes *= 2;
+
+	if (cantidad == 0) {
+		fprintf(stderr, "uso: %s [claves [baldes]]\n", argv[0]);
+		return 1;
+	}
+
+	funcion_t funciones[] = {
+		{ "rotativa", rotativa },
+		{ "fnv1a", hash_fnv1a },
+		{ "wyhash", hash_wyhash },
+		{ "crc32c", hash_crc32c }
+	};
+
+	corpus_t corpus[3];
+	bool creados = corpus_crear(&corpus[0], "urls", cantidad, escribir_url) &&
+		corpus_crear(&corpus[1], "uuids", cantidad, escribir_uuid) &&
+		corpus_crear(&corpus[2], "secuencial", cantidad, escribir_secuencial);
+
+	uint64_t* hashes = malloc(sizeof(uint64_t) * cantidad);
+	size_t* ocupacion = malloc(sizeof(size_t) * baldes);
+
+	if (!creados || !hashes || !ocupacion) {
+		fprintf(stderr, "no hay memoria\n");
+		return 1;
+	}
+
+	printf("%zu claves por corpus, %zu baldes (chi cuadrado esperado ~%zu)\n\n", cantidad, baldes, baldes - 1);
+	printf("%-12s %-10s %10s %14s %14s %11s\n", "corpus", "funcion", "MB/s", "chi2 crudo", "chi2 mezclado", "colisiones");
+
+	for (size_t c = 0; c < 3; c++) {
+		for (size_t f = 0; f < sizeof(funciones) / sizeof(funciones[0]); f++)
+			medir(&funciones[f], &corpus[c], baldes, hashes, ocupacion);
+	}
+
+	for (size_t c = 0; c < 3; c++)
+		corpus_destruir(&corpus[c]);
+
+	free(hashes);
+	free(ocupacion);
+
+	return 0;
+}
@@ -0,0 +1,140 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash.h"
+
+/* Cuenta cuántas veces llaman a malloc, calloc y realloc las primitivas del
+ * hash, por operación y para cada motor. Se enlaza con
+ * -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc (ver el Makefile), así que
+ * cuenta también las llamadas que hace Hash/hash.c.
+ *
+ * Uso: ./bench_hash_asignaciones [claves]   (por defecto 100000) */
+
+#define CLAVES_POR_DEFECTO 100000
+#define LARGO_CLAVE 32
+
+// Las funciones reales, que el enlazador deja con el prefijo __real_.
+void* __real_malloc(size_t tam);
+void* __real_calloc(size_t cantidad, size_t tam);
+void* __real_realloc(void* puntero, size_t tam);
+
+void* __wrap_malloc(size_t tam);
+void* __wrap_calloc(size_t cantidad, size_t tam);
+void* __wrap_realloc(void* puntero, size_t tam);
+
+static size_t asignaciones = 0;
+
+void* __wrap_malloc(size_t tam) {
+
+	asignaciones++;
+
+	return __real_malloc(tam);
+}
+
+void* __wrap_calloc(size_t cantidad, size_t tam) {
+
+	asignaciones++;
+
+	return __real_calloc(cantidad, tam);
+}
+
+void* __wrap_realloc(void* puntero, size_t tam) {
+
+	asignaciones++;
+
+	return __real_realloc(puntero, tam);
+}
+
+/* ******************************************************************
+ *                        PROGRAMA PRINCIPAL
+ * *****************************************************************/
+
+int main(int argc, char* argv[]) {
+
+	size_t cantidad = (argc > 1) ? strtoul(argv[1], NULL, 10) : CLAVES_POR_DEFECTO;
+
+	if (cantidad == 0) {
+		fprintf(stderr, "uso: %s [claves]\n", argv[0]);
+		return 1;
+	}
+
+	char (*claves)[LARGO_CLAVE] = malloc(LARGO_CLAVE * cantidad);
+	char (*ausentes)[LARGO_CLAVE] = malloc(LARGO_CLAVE * cantidad);
+
+	if (!claves || !ausentes) {
+		fprintf(stderr, "no hay memoria\n");
+		return 1;
+	}
+
+	for (size_t i = 0; i < cantidad; i++) {
+		snprintf(claves[i], LARGO_CLAVE, "clave:%zu", i);
+		snprintf(ausentes[i], LARGO_CLAVE, "ausente:%zu", i);
+	}
+
+	hash_tipo_t tipos[] = { HASH_ENCADENADO, HASH_ABIERTO, HASH_ORDENADO };
+	const char* nombres[] = { "encadenado", "abierto", "ordenado" };
+
+	printf("%zu claves (asignaciones por operacion)\n\n", cantidad);
+	printf("%-11s %9s %9s %9s %9s %9s %9s\n", "motor", "obtener", "ausentes", "pertenece", "reemplazo", "borrar_aus", "nueva");
+
+	for (size_t t = 0; t < sizeof(tipos) / sizeof(tipos[0]); t++) {
+
+		hash_t* hash = hash_crear_con_tipo(NULL, hash_wyhash, tipos[t]);
+
+		// La carga inicial sí asigna; se reserva antes para no medir redimensiones.
+		if (!hash || !hash_reservar(hash, 2 * cantidad)) {
+			fprintf(stderr, "no hay memoria\n");
+			return 1;
+		}
+
+		for (size_t i = 0; i < cantidad; i++)
+			hash_guardar(hash, claves[i], claves[i]);
+
+		size_t mediciones[6];
+		size_t antes;
+
+		antes = asignaciones;
+		for (size_t i = 0; i < cantidad; i++) hash_obtener(hash, claves[i]);
+		mediciones[0] = asignaciones - antes;
+
+		antes = asignaciones;
+		for (size_t i = 0; i < cantidad; i++) hash_obtener(hash, ausentes[i]);
+		mediciones[1] = asignaciones - antes;
+
+		antes = asignaciones;
+		for (size_t i = 0; i < cantidad; i++) hash_pertenece(hash, claves[i]);
+		mediciones[2] = asignaciones - antes;
+
+		antes = asignaciones;
+		for (size_t i = 0; i < cantidad; i++) hash_guardar(hash, claves[i], ausentes[i]);
+		mediciones[3] = asignaciones - antes;
+
+		antes = asignaciones;
+		for (size_t i = 0; i < cantidad; i++) hash_borrar_dato(hash, ausentes[i]);
+		mediciones[4] = asignaciones - antes;
+
+		// Guardar una clave nueva asigna su nodo (una vez); borrarla no asigna.
+		antes = asignaciones;
+		for (size_t i = 0; i < cantidad; i++) {
+			hash_guardar(hash, ausentes[i], ausentes[i]);
+			hash_borrar_dato(hash, ausentes[i]);
+		}
+		mediciones[5] = asignaciones - antes;
+
+		printf("%-11s", nombres[t]);
+
+		for (size_t i = 0; i < 6; i++)
+			printf(" %9.3f", (double) mediciones[i] / cantidad);
+
+		printf("\n");
+
+		hash_destruir(hash);
+	}
+
+	free(claves);
+	free(ausentes);
+
+	return 0;
+}
@@ -0,0 +1,250 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "hash.h"
+#include "hash_concurrente.h"
+
+/* Mide cuántas operaciones por segundo hacen de 1 a N hilos sobre un
+ * hash_concurrente_t y sobre un hash_t protegido por un único mutex (lo que
+ * reemplaza), con dos mezclas de operaciones sobre claves al azar:
+ *   lectura:   95% hash_obtener, 5% hash_guardar.
+ *   escritura: 50% hash_guardar, 50% hash_borrar_dato.
+ *
+ * Uso: ./bench_hash_concurrente [hilos_maximos [claves [operaciones_por_hilo]]]
+ * Por defecto, hasta el doble de procesadores, 1M claves y 1M operaciones. */
+
+#define CLAVES_POR_DEFECTO 1000000
+#define OPERACIONES_POR_DEFECTO 1000000
+#define LARGO_CLAVE 24
+
+typedef enum mezcla {
+	MEZCLA_LECTURA,
+	MEZCLA_ESCRITURA
+} mezcla_t;
+
+// Las dos tablas se usan con las mismas funciones, para medir lo mismo.
+typedef struct tabla {
+	const char* nombre;
+	void* datos;
+	bool (*guardar) (void* datos, const char* clave, void* dato);
+	void* (*obtener) (void* datos, const char* clave);
+	void* (*borrar) (void* datos, const char* clave);
+} tabla_t;
+
+typedef struct hash_con_mutex {
+	hash_t* hash;
+	pthread_mutex_t mutex;
+} hash_con_mutex_t;
+
+typedef struct trabajo {
+	const tabla_t* tabla;
+	char (*claves)[LARGO_CLAVE];
+	size_t cant_claves;
+	size_t operaciones;
+	mezcla_t mezcla;
+	uint64_t semilla;
+	size_t encontradas;
+} trabajo_t;
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+static uint64_t azar(uint64_t* estado) {
+
+	*estado ^= *estado << 13;
+	*estado ^= *estado >> 7;
+	*estado ^= *estado << 17;
+
+	return *estado;
+}
+
+static double ahora(void) {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double) t.tv_sec + (double) t.tv_nsec / 1e9;
+}
+
+static bool concurrente_guardar(void* datos, const char* clave, void* dato) {
+
+	return hash_concurrente_guardar(datos, clave, dato);
+}
+
+static void* concurrente_obtener(void* datos, const char* clave) {
+
+	return hash_concurrente_obtener(datos, clave);
+}
+
+static void* concurrente_borrar(void* datos, const char* clave) {
+
+	return hash_concurrente_borrar_dato(datos, clave);
+}
+
+static bool mutex_guardar(void* datos, const char* clave, void* dato) {
+
+	hash_con_mutex_t* tabla = datos;
+
+	pthread_mutex_lock(&tabla->mutex);
+	bool salida = hash_guardar(tabla->hash, clave, dato);
+	pthread_mutex_unlock(&tabla->mutex);
+
+	return salida;
+}
+
+static void* mutex_obtener(void* datos, const char* clave) {
+
+	hash_con_mutex_t* tabla = datos;
+
+	pthread_mutex_lock(&tabla->mutex);
+	void* dato = hash_obtener(tabla->hash, clave);
+	pthread_mutex_unlock(&tabla->mutex);
+
+	return dato;
+}
+
+static void* mutex_borrar(void* datos, const char* clave) {
+
+	hash_con_mutex_t* tabla = datos;
+
+	pthread_mutex_lock(&tabla->mutex);
+	void* dato = hash_borrar_dato(tabla->hash, clave);
+	pthread_mutex_unlock(&tabla->mutex);
+
+	return dato;
+}
+
+static void* trabajar(void* extra) {
+
+	trabajo_t* trabajo = extra;
+	const tabla_t* tabla = trabajo->tabla;
+	uint64_t estado = trabajo->semilla;
+
+	for (size_t i = 0; i < trabajo->operaciones; i++) {
+
+		uint64_t r = azar(&estado);
+		char* clave = trabajo->claves[(r >> 8) % trabajo->cant_claves];
+		size_t dado = r % 100;
+
+		if (trabajo->mezcla == MEZCLA_LECTURA && dado >= 5) {
+			if (tabla->obtener(tabla->datos, clave)) (trabajo->encontradas)++;
+		} else if (trabajo->mezcla == MEZCLA_LECTURA || dado < 50) {
+			tabla->guardar(tabla->datos, clave, clave);
+		} else {
+			if (tabla->borrar(tabla->datos, clave)) (trabajo->encontradas)++;
+		}
+	}
+
+	return NULL;
+}
+
+// Carga la mitad de las claves y devuelve las operaciones por segundo de
+// 'hilos' hilos trabajando a la vez.
+static double medir(const tabla_t* tabla, char (*claves)[LARGO_CLAVE], size_t cant_claves, size_t operaciones, mezcla_t mezcla, size_t hilos) {
+
+	for (size_t i = 0; i < cant_claves; i += 2)
+		tabla->guardar(tabla->datos, claves[i], claves[i]);
+
+	pthread_t* ids = malloc(sizeof(pthread_t) * hilos);
+	trabajo_t* trabajos = malloc(sizeof(trabajo_t) * hilos);
+
+	if (!ids || !trabajos) {
+		free(ids);
+		free(trabajos);
+		return 0;
+	}
+
+	double inicio = ahora();
+
+	for (size_t i = 0; i < hilos; i++) {
+
+		trabajo_t trabajo = { tabla, claves, cant_claves, operaciones, mezcla, 0x9e3779b97f4a7c15ULL * (i + 1), 0 };
+		trabajos[i] = trabajo;
+
+		if (pthread_create(&ids[i], NULL, trabajar, &trabajos[i]) != 0) {
+			fprintf(stderr, "no se pudo crear el hilo %zu\n", i);
+			exit(1);
+		}
+	}
+
+	for (size_t i = 0; i < hilos; i++)
+		pthread_join(ids[i], NULL);
+
+	double segundos = ahora() - inicio;
+
+	// Deja la tabla vacía para la próxima medición.
+	for (size_t i = 0; i < cant_claves; i++)
+		tabla->borrar(tabla->datos, claves[i]);
+
+	free(ids);
+	free(trabajos);
+
+	return (double) operaciones * hilos / segundos;
+}
+
+/* ******************************************************************
+ *                        PROGRAMA PRINCIPAL
+ * *****************************************************************/
+
+int main(int argc, char* argv[]) {
+
+	long procesadores = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t maximo = (argc > 1) ? strtoul(argv[1], NULL, 10) : (procesadores > 0 ? 2 * (size_t) procesadores : 2);
+	size_t cant_claves = (argc > 2) ? strtoul(argv[2], NULL, 10) : CLAVES_POR_DEFECTO;
+	size_t operaciones = (argc > 3) ? strtoul(argv[3], NULL, 10) : OPERACIONES_POR_DEFECTO;
+
+	if (maximo == 0 || cant_claves == 0) {
+		fprintf(stderr, "uso: %s [hilos_maximos [claves [operaciones_por_hilo]]]\n", argv[0]);
+		return 1;
+	}
+
+	char (*claves)[LARGO_CLAVE] = malloc(LARGO_CLAVE * cant_claves);
+	hash_concurrente_t* concurrente = hash_concurrente_crear(NULL, hash_wyhash);
+	hash_con_mutex_t con_mutex = { hash_crear(NULL, hash_wyhash) };
+
+	if (!claves || !concurrente || !con_mutex.hash || pthread_mutex_init(&con_mutex.mutex, NULL) != 0) {
+		fprintf(stderr, "no hay memoria\n");
+		return 1;
+	}
+
+	for (size_t i = 0; i < cant_claves; i++)
+		snprintf(claves[i], LARGO_CLAVE, "usuario:%zu", i * 7919);
+
+	tabla_t tablas[] = {
+		{ "concurrente", concurrente, concurrente_guardar, concurrente_obtener, concurrente_borrar },
+		{ "mutex", &con_mutex, mutex_guardar, mutex_obtener, mutex_borrar }
+	};
+
+	printf("%ld procesadores, %zu claves, %zu operaciones por hilo (Mops/s)\n\n", procesadores, cant_claves, operaciones);
+	printf("%6s %14s %14s %14s %14s\n", "hilos", "lect. concurr.", "lect. mutex", "escr. concurr.", "escr. mutex");
+
+	// 1, 2, 4... hasta el máximo, que se mide aunque no sea potencia de 2.
+	for (size_t hilos = 1; ; hilos *= 2) {
+
+		if (hilos > maximo) hilos = maximo;
+
+		printf("%6zu", hilos);
+
+		for (mezcla_t mezcla = MEZCLA_LECTURA; mezcla <= MEZCLA_ESCRITURA; mezcla++) {
+			for (size_t t = 0; t < 2; t++)
+				printf(" %14.2f", medir(&tablas[t], claves, cant_claves, operaciones, mezcla, hilos) / 1e6);
+		}
+
+		printf("\n");
+
+		if (hilos == maximo) break;
+	}
+
+	hash_concurrente_destruir(concurrente);
+	hash_destruir(con_mutex.hash);
+	pthread_mutex_destroy(&con_mutex.mutex);
+	free(claves);
+
+	return 0;
+}
@@ -0,0 +1,127 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "hash.h"
+
+/* Compara cuánto tarda cargar n pares en una tabla nueva con:
+ *   guardar:    un ciclo de hash_guardar sobre hash_crear, que redimensiona.
+ *   reservada:  un ciclo de hash_guardar sobre hash_crear_con_capacidad.
+ *   construir:  hash_construir con 1, 2, 4... hasta N hilos.
+ * Después de cada carga verifica que estén todas las claves.
+ *
+ * Uso: ./bench_hash_construir [hilos_maximos [pares]]
+ * Por defecto, hasta el doble de procesadores y 2M pares. */
+
+#define PARES_POR_DEFECTO 2000000
+#define LARGO_CLAVE 24
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+static double ahora(void) {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double) t.tv_sec + (double) t.tv_nsec / 1e9;
+}
+
+// Verifica que la tabla tenga exactamente los pares y la destruye.
+static void verificar_y_destruir(hash_t* hash, const hash_par_t* pares, size_t n, const char* forma) {
+
+	if (!hash) {
+		fprintf(stderr, "error: %s no pudo crear la tabla\n", forma);
+		exit(1);
+	}
+
+	size_t encontrados = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		if (hash_obtener(hash, pares[i].clave) == pares[i].dato) encontrados++;
+	}
+
+	if (encontrados != n || hash_cantidad(hash) != n) {
+		fprintf(stderr, "error: %s tiene %zu elementos, %zu de %zu correctos\n", forma, hash_cantidad(hash), encontrados, n);
+		exit(1);
+	}
+
+	hash_destruir(hash);
+}
+
+/* ******************************************************************
+ *                        PROGRAMA PRINCIPAL
+ * *****************************************************************/
+
+int main(int argc, char* argv[]) {
+
+	long procesadores = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t maximo = (argc > 1) ? strtoul(argv[1], NULL, 10) : (procesadores > 0 ? 2 * (size_t) procesadores : 2);
+	size_t n = (argc > 2) ? strtoul(argv[2], NULL, 10) : PARES_POR_DEFECTO;
+
+	if (maximo == 0 || n == 0) {
+		fprintf(stderr, "uso: %s [hilos_maximos [pares]]\n", argv[0]);
+		return 1;
+	}
+
+	char (*claves)[LARGO_CLAVE] = malloc(LARGO_CLAVE * n);
+	hash_par_t* pares = malloc(sizeof(hash_par_t) * n);
+
+	if (!claves || !pares) {
+		fprintf(stderr, "no hay memoria\n");
+		return 1;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		snprintf(claves[i], LARGO_CLAVE, "usuario:%zu", i * 7919);
+		pares[i].clave = claves[i];
+		pares[i].dato = claves[i];
+	}
+
+	printf("%ld procesadores, %zu pares (segundos)\n\n", procesadores, n);
+	printf("%-16s %10s\n", "forma", "segundos");
+
+	double inicio = ahora();
+	hash_t* hash = hash_crear(NULL, hash_wyhash);
+
+	for (size_t i = 0; hash && i < n; i++)
+		hash_guardar(hash, pares[i].clave, pares[i].dato);
+
+	printf("%-16s %10.3f\n", "guardar", ahora() - inicio);
+	verificar_y_destruir(hash, pares, n, "guardar");
+
+	inicio = ahora();
+	hash = hash_crear_con_capacidad(NULL, hash_wyhash, n);
+
+	for (size_t i = 0; hash && i < n; i++)
+		hash_guardar(hash, pares[i].clave, pares[i].dato);
+
+	printf("%-16s %10.3f\n", "reservada", ahora() - inicio);
+	verificar_y_destruir(hash, pares, n, "reservada");
+
+	// 1, 2, 4... hasta el máximo, que se mide aunque no sea potencia de 2.
+	for (size_t hilos = 1; ; hilos *= 2) {
+
+		if (hilos > maximo) hilos = maximo;
+
+		inicio = ahora();
+		hash = hash_construir(pares, n, NULL, hash_wyhash, hilos);
+		double segundos = ahora() - inicio;
+
+		char forma[32];
+		snprintf(forma, sizeof(forma), "construir (%zu)", hilos);
+		printf("%-16s %10.3f\n", forma, segundos);
+		verificar_y_destruir(hash, pares, n, forma);
+
+		if (hilos == maximo) break;
+	}
+
+	free(claves);
+	free(pares);
+
+	return 0;
+}
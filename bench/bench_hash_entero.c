@@ -0,0 +1,174 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "hash.h"
+#include "hash_entero.h"
+
+/* Compara tres formas de usar identificadores enteros como claves:
+ *   entero: hash_entero_t, con la clave uint64_t guardada en la ranura.
+ *   binaria: hash_t con los 8 bytes del entero (hash_obtener_bin).
+ *   texto: hash_t con el entero escrito en decimal (hash_obtener). Se mide
+ *          con los textos ya escritos y escribiéndolos en cada búsqueda,
+ *          que es lo que hacía quien sólo tenía claves de texto.
+ * Para cada una mide cuántos nanosegundos tarda guardar cada clave y
+ * buscar claves al azar.
+ *
+ * Uso: ./bench_hash_entero [claves [busquedas]]
+ * Por defecto 1M claves y 5M búsquedas. */
+
+#define CLAVES_POR_DEFECTO 1000000
+#define BUSQUEDAS_POR_DEFECTO 5000000
+#define LARGO_TEXTO 24
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+static uint64_t azar(uint64_t* estado) {
+
+	*estado ^= *estado << 13;
+	*estado ^= *estado >> 7;
+	*estado ^= *estado << 17;
+
+	return *estado;
+}
+
+static double ahora(void) {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double) t.tv_sec + (double) t.tv_nsec / 1e9;
+}
+
+static void verificar(size_t encontradas, size_t esperadas, const char* forma) {
+
+	if (encontradas != esperadas) {
+		fprintf(stderr, "error: %s encontro %zu de %zu\n", forma, encontradas, esperadas);
+		exit(1);
+	}
+}
+
+/* ******************************************************************
+ *                        PROGRAMA PRINCIPAL
+ * *****************************************************************/
+
+int main(int argc, char* argv[]) {
+
+	size_t cantidad = (argc > 1) ? strtoul(argv[1], NULL, 10) : CLAVES_POR_DEFECTO;
+	size_t busquedas = (argc > 2) ? strtoul(argv[2], NULL, 10) : BUSQUEDAS_POR_DEFECTO;
+
+	if (cantidad == 0 || busquedas == 0) {
+		fprintf(stderr, "uso: %s [claves [busquedas]]\n", argv[0]);
+		return 1;
+	}
+
+	uint64_t* ids = malloc(sizeof(uint64_t) * cantidad);
+	char (*textos)[LARGO_TEXTO] = malloc(LARGO_TEXTO * cantidad);
+	size_t* pedidas = malloc(sizeof(size_t) * busquedas);
+
+	hash_entero_t* entero = hash_entero_crear(NULL);
+	hash_t* binaria = hash_crear(NULL, hash_wyhash);
+	hash_t* texto = hash_crear(NULL, hash_wyhash);
+
+	if (!ids || !textos || !pedidas || !entero || !binaria || !texto) {
+		fprintf(stderr, "no hay memoria\n");
+		return 1;
+	}
+
+	uint64_t estado = 0x9e3779b97f4a7c15ULL;
+
+	// Identificadores dispersos, como los de una base de datos con huecos.
+	for (size_t i = 0; i < cantidad; i++) {
+		ids[i] = i * 7919 + 1;
+		snprintf(textos[i], LARGO_TEXTO, "%llu", (unsigned long long) ids[i]);
+	}
+
+	// Los índices de las búsquedas se eligen antes, para no medir al generador.
+	for (size_t i = 0; i < busquedas; i++)
+		pedidas[i] = azar(&estado) % cantidad;
+
+	double inicio = ahora();
+
+	for (size_t i = 0; i < cantidad; i++)
+		hash_entero_guardar(entero, ids[i], &ids[i]);
+
+	double guardar_entero = (ahora() - inicio) * 1e9 / cantidad;
+
+	inicio = ahora();
+
+	for (size_t i = 0; i < cantidad; i++)
+		hash_guardar_bin(binaria, &ids[i], sizeof(uint64_t), &ids[i]);
+
+	double guardar_binaria = (ahora() - inicio) * 1e9 / cantidad;
+
+	inicio = ahora();
+
+	for (size_t i = 0; i < cantidad; i++)
+		hash_guardar(texto, textos[i], &ids[i]);
+
+	double guardar_texto = (ahora() - inicio) * 1e9 / cantidad;
+
+	size_t encontradas = 0;
+
+	inicio = ahora();
+
+	for (size_t i = 0; i < busquedas; i++) {
+		if (hash_entero_obtener(entero, ids[pedidas[i]]) == &ids[pedidas[i]]) encontradas++;
+	}
+
+	double obtener_entero = (ahora() - inicio) * 1e9 / busquedas;
+	verificar(encontradas, busquedas, "entero");
+	encontradas = 0;
+
+	inicio = ahora();
+
+	for (size_t i = 0; i < busquedas; i++) {
+		uint64_t id = ids[pedidas[i]];
+		if (hash_obtener_bin(binaria, &id, sizeof(uint64_t)) == &ids[pedidas[i]]) encontradas++;
+	}
+
+	double obtener_binaria = (ahora() - inicio) * 1e9 / busquedas;
+	verificar(encontradas, busquedas, "binaria");
+	encontradas = 0;
+
+	inicio = ahora();
+
+	for (size_t i = 0; i < busquedas; i++) {
+		if (hash_obtener(texto, textos[pedidas[i]]) == &ids[pedidas[i]]) encontradas++;
+	}
+
+	double obtener_texto = (ahora() - inicio) * 1e9 / busquedas;
+	verificar(encontradas, busquedas, "texto");
+	encontradas = 0;
+
+	inicio = ahora();
+
+	for (size_t i = 0; i < busquedas; i++) {
+		char clave[LARGO_TEXTO];
+		snprintf(clave, LARGO_TEXTO, "%llu", (unsigned long long) ids[pedidas[i]]);
+		if (hash_obtener(texto, clave) == &ids[pedidas[i]]) encontradas++;
+	}
+
+	double obtener_formato = (ahora() - inicio) * 1e9 / busquedas;
+	verificar(encontradas, busquedas, "texto escrito al buscar");
+
+	printf("%zu claves, %zu busquedas (ns por operacion)\n\n", cantidad, busquedas);
+	printf("%-24s %10s %10s\n", "forma", "guardar", "obtener");
+	printf("%-24s %10.1f %10.1f\n", "entero", guardar_entero, obtener_entero);
+	printf("%-24s %10.1f %10.1f\n", "binaria", guardar_binaria, obtener_binaria);
+	printf("%-24s %10.1f %10.1f\n", "texto", guardar_texto, obtener_texto);
+	printf("%-24s %10s %10.1f\n", "texto escrito al buscar", "", obtener_formato);
+
+	hash_entero_destruir(entero);
+	hash_destruir(binaria);
+	hash_destruir(texto);
+	free(ids);
+	free(textos);
+	free(pedidas);
+
+	return 0;
+}
@@ -0,0 +1,156 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "hash.h"
+
+/* Compara hash_obtener_lote y hash_guardar_lote con un ciclo de
+ * hash_obtener o hash_guardar por clave, en cada motor. Las claves se piden
+ * en orden al azar y en lotes de 'lote' claves, sobre una tabla más grande
+ * que la memoria cache, que es el caso en el que los lotes solapan las
+ * esperas a memoria de claves distintas.
+ *
+ * Uso: ./bench_hash_lote [claves [busquedas [lote]]]
+ * Por defecto 1M claves, 4M búsquedas y lotes de 1000. */
+
+#define CLAVES_POR_DEFECTO 1000000
+#define BUSQUEDAS_POR_DEFECTO 4000000
+#define LOTE_POR_DEFECTO 1000
+#define LARGO_CLAVE 32
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+static uint64_t azar(uint64_t* estado) {
+
+	*estado ^= *estado << 13;
+	*estado ^= *estado >> 7;
+	*estado ^= *estado << 17;
+
+	return *estado;
+}
+
+static double ahora(void) {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double) t.tv_sec + (double) t.tv_nsec / 1e9;
+}
+
+/* ******************************************************************
+ *                        PROGRAMA PRINCIPAL
+ * *****************************************************************/
+
+int main(int argc, char* argv[]) {
+
+	size_t cantidad = (argc > 1) ? strtoul(argv[1], NULL, 10) : CLAVES_POR_DEFECTO;
+	size_t busquedas = (argc > 2) ? strtoul(argv[2], NULL, 10) : BUSQUEDAS_POR_DEFECTO;
+	size_t lote = (argc > 3) ? strtoul(argv[3], NULL, 10) : LOTE_POR_DEFECTO;
+
+	if (cantidad == 0 || lote == 0 || busquedas < lote) {
+		fprintf(stderr, "uso: %s [claves [busquedas [lote]]]\n", argv[0]);
+		return 1;
+	}
+
+	// Se busca siempre en lotes completos.
+	busquedas -= busquedas % lote;
+
+	char (*textos)[LARGO_CLAVE] = malloc(LARGO_CLAVE * cantidad);
+	const char* *claves = malloc(sizeof(char*) * cantidad);
+	const char* *pedidas = malloc(sizeof(char*) * busquedas);
+	void* *resultados = malloc(sizeof(void*) * lote);
+
+	if (!textos || !claves || !pedidas || !resultados) {
+		fprintf(stderr, "no hay memoria\n");
+		return 1;
+	}
+
+	uint64_t estado = 0x9e3779b97f4a7c15ULL;
+
+	for (size_t i = 0; i < cantidad; i++) {
+		snprintf(textos[i], LARGO_CLAVE, "clave:%zu", i * 7919);
+		claves[i] = textos[i];
+	}
+
+	// Las claves de cada búsqueda se eligen antes, para no medir al generador.
+	for (size_t i = 0; i < busquedas; i++)
+		pedidas[i] = claves[azar(&estado) % cantidad];
+
+	hash_tipo_t tipos[] = { HASH_ENCADENADO, HASH_ABIERTO, HASH_ORDENADO };
+	const char* nombres[] = { "encadenado", "abierto", "ordenado" };
+
+	printf("%zu claves, %zu busquedas en lotes de %zu (ns por clave)\n\n", cantidad, busquedas, lote);
+	printf("%-11s %10s %10s %10s %10s\n", "motor", "guardar", "g. lote", "obtener", "o. lote");
+
+	for (size_t t = 0; t < sizeof(tipos) / sizeof(tipos[0]); t++) {
+
+		hash_t* uno = hash_crear_con_tipo(NULL, hash_wyhash, tipos[t]);
+		hash_t* en_lote = hash_crear_con_tipo(NULL, hash_wyhash, tipos[t]);
+
+		if (!uno || !en_lote || !hash_reservar(uno, cantidad) || !hash_reservar(en_lote, cantidad)) {
+			fprintf(stderr, "no hay memoria\n");
+			return 1;
+		}
+
+		double inicio = ahora();
+
+		for (size_t i = 0; i < cantidad; i++)
+			hash_guardar(uno, claves[i], (void*) claves[i]);
+
+		double guardar = (ahora() - inicio) * 1e9 / cantidad;
+
+		inicio = ahora();
+
+		for (size_t i = 0; i < cantidad; i += lote) {
+
+			size_t n = (cantidad - i < lote) ? cantidad - i : lote;
+
+			hash_guardar_lote(en_lote, &claves[i], (void* const*) &claves[i], n);
+		}
+
+		double guardar_lote = (ahora() - inicio) * 1e9 / cantidad;
+		size_t encontradas = 0;
+
+		inicio = ahora();
+
+		for (size_t i = 0; i < busquedas; i++) {
+			if (hash_obtener(uno, pedidas[i]) == pedidas[i]) encontradas++;
+		}
+
+		double obtener = (ahora() - inicio) * 1e9 / busquedas;
+
+		inicio = ahora();
+
+		for (size_t i = 0; i < busquedas; i += lote) {
+
+			hash_obtener_lote(en_lote, &pedidas[i], lote, resultados);
+
+			for (size_t j = 0; j < lote; j++) {
+				if (resultados[j] == pedidas[i + j]) encontradas++;
+			}
+		}
+
+		double obtener_lote = (ahora() - inicio) * 1e9 / busquedas;
+
+		if (encontradas != 2 * busquedas) {
+			fprintf(stderr, "error: %zu de %zu encontradas\n", encontradas, 2 * busquedas);
+			return 1;
+		}
+
+		printf("%-11s %10.1f %10.1f %10.1f %10.1f\n", nombres[t], guardar, guardar_lote, obtener, obtener_lote);
+
+		hash_destruir(uno);
+		hash_destruir(en_lote);
+	}
+
+	free(textos);
+	free(claves);
+	free(pedidas);
+	free(resultados);
+
+	return 0;
+}
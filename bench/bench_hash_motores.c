@@ -0,0 +1,165 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "hash.h"
+
+/* Compara la tabla encadenada (HASH_ENCADENADO) con la de direccionamiento
+ * abierto (HASH_ABIERTO) con el mismo tamaño de tabla y distintos factores
+ * de carga (elementos por balde o por ranura). Para cada uno mide cuántos
+ * nanosegundos tarda guardar una clave nueva y buscar, en orden al azar,
+ * claves que están y claves que no están, y cuántos bytes ocupa cada
+ * elemento. La abierta crece al llenar 7/8 de sus ranuras, así que no se
+ * mide con factores mayores.
+ *
+ * Uso: ./bench_hash_motores [log2_del_tamanio [busquedas]]
+ * Por defecto, tablas de 2^20 baldes y 4M búsquedas de cada tipo. */
+
+#define LOG_TAMANIO_POR_DEFECTO 20
+#define BUSQUEDAS_POR_DEFECTO 4000000
+#define LARGO_CLAVE 24
+
+/* ******************************************************************
+ *                       FUNCIONES AUXILIARES
+ * *****************************************************************/
+
+static uint64_t azar(uint64_t* estado) {
+
+	*estado ^= *estado << 13;
+	*estado ^= *estado >> 7;
+	*estado ^= *estado << 17;
+
+	return *estado;
+}
+
+static double ahora(void) {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double) t.tv_sec + (double) t.tv_nsec / 1e9;
+}
+
+// Crea una tabla vacía del tipo pedido con exactamente 'tamanio' baldes, que
+// no crece hasta pasar el factor de carga más alto que se mide.
+static hash_t* crear_tabla(hash_tipo_t tipo, size_t tamanio) {
+
+	hash_t* hash = hash_crear_con_tipo(NULL, hash_wyhash, tipo);
+
+	if (!hash) return NULL;
+
+	// La encadenada crece al llegar a factor_max elementos por balde; la
+	// abierta, al llenar 7/8 de las ranuras.
+	if (tipo == HASH_ENCADENADO) hash_configurar_factores(hash, 0, 2);
+
+	size_t reserva = (tipo == HASH_ENCADENADO) ? 2 * tamanio - 1 : tamanio * 7 / 8 - 1;
+
+	if (!hash_reservar(hash, reserva)) {
+		hash_destruir(hash);
+		return NULL;
+	}
+
+	return hash;
+}
+
+// Busca 'busquedas' claves al azar entre las primeras 'cantidad' y
+// devuelve los nanosegundos por búsqueda. Cuenta las encontradas en *encontradas.
+static double medir_busquedas(const hash_t* hash, char (*claves)[LARGO_CLAVE], size_t cantidad, size_t busquedas, size_t* encontradas) {
+
+	uint64_t estado = 0x9e3779b97f4a7c15ULL;
+	double inicio = ahora();
+
+	for (size_t i = 0; i < busquedas; i++) {
+		if (hash_obtener(hash, claves[azar(&estado) % cantidad])) (*encontradas)++;
+	}
+
+	return (ahora() - inicio) * 1e9 / busquedas;
+}
+
+static void medir(hash_tipo_t tipo, size_t tamanio, double factor, char (*claves)[LARGO_CLAVE], char (*ausentes)[LARGO_CLAVE], size_t busquedas) {
+
+	size_t cantidad = (size_t) (factor * tamanio);
+
+	// La abierta admite hasta 7/8 de las ranuras menos una.
+	if (tipo == HASH_ABIERTO && cantidad >= tamanio * 7 / 8) cantidad = tamanio * 7 / 8 - 1;
+
+	hash_t* hash = crear_tabla(tipo, tamanio);
+
+	if (!hash) {
+		fprintf(stderr, "no hay memoria\n");
+		exit(1);
+	}
+
+	double inicio = ahora();
+
+	for (size_t i = 0; i < cantidad; i++)
+		hash_guardar(hash, claves[i], claves[i]);
+
+	double guardar = (ahora() - inicio) * 1e9 / cantidad;
+
+	size_t encontradas = 0, falsas = 0;
+	double presentes = medir_busquedas(hash, claves, cantidad, busquedas, &encontradas);
+	double no_presentes = medir_busquedas(hash, ausentes, cantidad, busquedas, &falsas);
+
+	hash_estadisticas_t estadisticas;
+	hash_estadisticas(hash, &estadisticas);
+
+	if (encontradas != busquedas || falsas != 0 || estadisticas.baldes != tamanio) {
+		fprintf(stderr, "error: %zu de %zu encontradas, %zu falsas, %zu baldes\n", encontradas, busquedas, falsas, estadisticas.baldes);
+		exit(1);
+	}
+
+	printf("%-11s %6.3f %12.1f %12.1f %12.1f %12.1f\n", (tipo == HASH_ENCADENADO) ? "encadenado" : "abierto",
+		(double) cantidad / tamanio, guardar, presentes, no_presentes, (double) estadisticas.bytes / cantidad);
+
+	hash_destruir(hash);
+}
+
+/* ******************************************************************
+ *                        PROGRAMA PRINCIPAL
+ * *****************************************************************/
+
+int main(int argc, char* argv[]) {
+
+	size_t log_tamanio = (argc > 1) ? strtoul(argv[1], NULL, 10) : LOG_TAMANIO_POR_DEFECTO;
+	size_t busquedas = (argc > 2) ? strtoul(argv[2], NULL, 10) : BUSQUEDAS_POR_DEFECTO;
+
+	if (log_tamanio < 6 || log_tamanio > 30 || busquedas == 0) {
+		fprintf(stderr, "uso: %s [log2_del_tamanio (6 a 30) [busquedas]]\n", argv[0]);
+		return 1;
+	}
+
+	size_t tamanio = (size_t) 1 << log_tamanio;
+	size_t maximo = tamanio * 3 / 2;
+	char (*claves)[LARGO_CLAVE] = malloc(LARGO_CLAVE * maximo);
+	char (*ausentes)[LARGO_CLAVE] = malloc(LARGO_CLAVE * maximo);
+
+	if (!claves || !ausentes) {
+		fprintf(stderr, "no hay memoria\n");
+		return 1;
+	}
+
+	for (size_t i = 0; i < maximo; i++) {
+		snprintf(claves[i], LARGO_CLAVE, "clave:%zu", i * 7919);
+		snprintf(ausentes[i], LARGO_CLAVE, "ausente:%zu", i * 7919);
+	}
+
+	double factores[] = { 0.25, 0.5, 0.75, 0.875, 1.0, 1.5 };
+
+	printf("tablas de %zu baldes, %zu busquedas (ns por operacion)\n\n", tamanio, busquedas);
+	printf("%-11s %6s %12s %12s %12s %12s\n", "motor", "carga", "guardar", "obtener", "ausentes", "bytes/elem");
+
+	for (size_t f = 0; f < sizeof(factores) / sizeof(factores[0]); f++) {
+
+		medir(HASH_ENCADENADO, tamanio, factores[f], claves, ausentes, busquedas);
+
+		if (factores[f] < 1) medir(HASH_ABIERTO, tamanio, factores[f], claves, ausentes, busquedas);
+	}
+
+	free(claves);
+	free(ausentes);
+
+	return 0;
+}